@@ -1,27 +1,21 @@
-QT       += core gui network
-QT       += charts
+# core - biblioteka (QtCore/QtNetwork): pobieranie, parsowanie, magazyn i analiza danych
+# gui  - aplikacja okienkowa na bazie core
+# cli  - program konsolowy/demon działający bez serwera wyświetlania
+# benchmarks - mikrobenchmarki QtTest (QBENCHMARK)
+# mockserver - lokalny serwer zastępujący API GIOŚ do testów obciążeniowych
+# tests - testy QtTest biblioteki core i okna gui (make check)
+TEMPLATE = subdirs
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+SUBDIRS += \
+    core \
+    gui \
+    cli \
+    benchmarks \
+    mockserver \
+    tests
 
-CONFIG += c++17
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    apimanager.cpp \
-    main.cpp \
-    mainwindow.cpp
-
-HEADERS += \
-    apimanager.h \
-    mainwindow.h
-
-FORMS += \
-    mainwindow.ui
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
+gui.depends = core
+cli.depends = core
+benchmarks.depends = core
+mockserver.depends = core
+tests.depends = core
@@ -0,0 +1,189 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "benchmarks.h"
+#include "downsample.h"
+#include "giosparser.h"
+#include "seriesanalysis.h"
+#include "seriesexport.h"
+#include "seriesstore.h"
+#include "stationmodel.h"
+#include "syntheticdata.h"
+
+/**
+ * @brief Benchmarki ścieżek aplikacji na danych syntetycznych: dekodowanie odpowiedzi,
+ * filtrowanie listy stacji, analiza, budowa serii wykresu i eksport CSV.
+ */
+class BenchPipeline : public QObject {
+    Q_OBJECT
+
+private:
+    static void addPointRows(std::initializer_list<int> sizes) {
+        QTest::addColumn<int>("points");
+        for (int points : sizes) {
+            QTest::addRow("%d", points) << points;
+        }
+    }
+
+private slots:
+    // Dekodowanie station/findAll jak w ApiManager::onReplyFinished
+    void decodeStations_data() {
+        QTest::addColumn<int>("stations");
+        for (int stations : {300, 3000, 30000}) {
+            QTest::addRow("%d", stations) << stations;
+        }
+    }
+
+    void decodeStations() {
+        QFETCH(int, stations);
+        const QByteArray json = SyntheticData::stationsJson(stations);
+        QList<Station> result;
+        QBENCHMARK {
+            QVERIFY(GiosParser::parseStations(json, result));
+        }
+        QCOMPARE(result.size(), qsizetype(stations));
+    }
+
+    void decodeSensors() {
+        const QByteArray json = SyntheticData::sensorsJson(114, 7);
+        QList<Sensor> result;
+        QBENCHMARK {
+            QVERIFY(GiosParser::parseSensors(json, result));
+        }
+        QCOMPARE(result.size(), qsizetype(7));
+    }
+
+    // data/getData: dekodowanie JSON i przejście na kolumny, jak przy odbiorze pomiarów
+    void decodeMeasurements_data() { addPointRows({100, 10000, 1000000}); }
+
+    void decodeMeasurements() {
+        QFETCH(int, points);
+        const QByteArray json = SyntheticData::measurementsJson("PM10", points);
+        SeriesColumns columns;
+        QBENCHMARK {
+            MeasurementSeries series;
+            QVERIFY(GiosParser::parseMeasurements(json, series));
+            columns = SeriesStore::columnsFromPoints(series.values);
+        }
+        QCOMPARE(columns.size(), qsizetype(points));
+    }
+
+    // MainWindow::filterStationsByCity: zapytanie do indeksu i przefiltrowanie modelu
+    void filterStations_data() {
+        QTest::addColumn<int>("stations");
+        QTest::addColumn<QString>("query");
+        for (int stations : {300, 30000}) {
+            for (const char *query : {"kr", "Łódź", "biala", "gora 3"}) {
+                QTest::addRow("%d/%s", stations, query) << stations << QString::fromUtf8(query);
+            }
+        }
+    }
+
+    void filterStations() {
+        QFETCH(int, stations);
+        QFETCH(QString, query);
+        StationListModel model;
+        model.setStations(SyntheticData::stations(stations));
+        StationFilterProxy proxy;
+        proxy.setSourceModel(&model);
+        QBENCHMARK {
+            proxy.setSearchText(query);
+            proxy.setSearchText(QString());
+        }
+        proxy.setSearchText(query);
+        QVERIFY(proxy.rowCount() <= stations);
+    }
+
+    // Analiza z on_analyzeButton_clicked: pełny przebieg po kolumnach i wariant z gotowego agregatu
+    void analyze_data() { addPointRows({100, 10000, 1000000, 10000000}); }
+
+    void analyze() {
+        QFETCH(int, points);
+        const SeriesColumns series = SyntheticData::series(points);
+        AnalysisResult result;
+        QBENCHMARK {
+            result = SeriesAnalysis::analyze("PM10", series);
+        }
+        QVERIFY(result.count > 0);
+    }
+
+    void analyzeAggregate_data() { addPointRows({100, 1000000}); }
+
+    void analyzeAggregate() {
+        QFETCH(int, points);
+        SeriesStore store;
+        const SeriesKey key{114, "PM10"};
+        store.insert(key, SyntheticData::series(points));
+        AnalysisResult result;
+        QBENCHMARK {
+            result = SeriesAnalysis::fromAggregate(key.paramCode, store.aggregate(key));
+        }
+        QVERIFY(result.count > 0);
+    }
+
+    // Dane serii w drawChart: zapytanie na poziomie dobranym do szerokości i redukcja LTTB;
+    // budowa QLineSeries nie jest mierzona - cel nie linkuje QtCharts ani QtGui
+    void chartSeries_data() { addPointRows({100, 10000, 1000000}); }
+
+    void chartSeries() {
+        QFETCH(int, points);
+        SeriesStore store;
+        const SeriesKey key{114, "PM10"};
+        store.insert(key, SyntheticData::series(points));
+        const qint64 from = SyntheticData::seriesStart();
+        const qint64 to = from + qint64(points) * 3600 * 1000;
+        QList<QPointF> result;
+        QBENCHMARK {
+            const RollupQuery query = store.query(key, from, to, 800);
+            QList<QPointF> chartPoints;
+            chartPoints.reserve(query.buckets.size());
+            for (const RollupBucket &bucket : query.buckets) {
+                chartPoints.append(QPointF(bucket.start, bucket.mean()));
+            }
+            result = Downsample::lttb(chartPoints, 800);
+        }
+        QVERIFY(!result.isEmpty());
+    }
+
+    void exportCsv_data() {
+        QTest::addColumn<int>("layout");
+        QTest::addColumn<int>("points");
+        for (int points : {10000, 1000000}) {
+            QTest::addRow("long/%d", points) << int(ExportOptions::Layout::LongCsv) << points;
+            QTest::addRow("wide/%d", points) << int(ExportOptions::Layout::WideCsv) << points;
+        }
+    }
+
+    void exportCsv() {
+        QFETCH(int, layout);
+        QFETCH(int, points);
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const SeriesColumns series = SyntheticData::series(points);
+        const SeriesSource source = [&series](const SeriesKey &, qint64 from, qint64 to) {
+            const SeriesSlice slice = series.slice(from, to);
+            SeriesColumns result;
+            result.reserve(slice.size());
+            for (qsizetype i = slice.begin; i < slice.end; ++i) {
+                result.append(series.timestamp(i), series.value(i), series.isValid(i));
+            }
+            return result;
+        };
+
+        ExportOptions options;
+        options.path = dir.filePath("eksport.csv");
+        options.layout = ExportOptions::Layout(layout);
+        options.keys << SeriesKey{114, "PM10"} << SeriesKey{114, "PM2.5"};
+        QBENCHMARK {
+            QCOMPARE(SeriesExporter::run(options, source), QString());
+        }
+        QVERIFY(QFileInfo(options.path).size() > 0);
+    }
+};
+
+int runBenchPipeline(const QStringList &arguments)
+{
+    BenchPipeline bench;
+    return QTest::qExec(&bench, arguments);
+}
+
+#include "bench_pipeline.moc"
@@ -0,0 +1,107 @@
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonObject>
+#include "benchmarks.h"
+#include "seriesstore.h"
+#include "statkernels.h"
+#include "syntheticdata.h"
+
+/**
+ * @brief Mikrobenchmark jąder statystyk względem dotychczasowej analizy po QJsonArray.
+ */
+class BenchStatKernels : public QObject {
+    Q_OBJECT
+
+private:
+    static QJsonArray toJson(const SeriesColumns &series) {
+        QJsonArray array;
+        for (qsizetype i = 0; i < series.size(); ++i) {
+            QJsonObject v;
+            v["date"] = QDateTime::fromMSecsSinceEpoch(series.timestamp(i)).toString("yyyy-MM-dd HH:mm:ss");
+            v["value"] = series.isValid(i) ? QJsonValue(series.value(i)) : QJsonValue(QJsonValue::Null);
+            array.append(v);
+        }
+        return array;
+    }
+
+    // Dotychczasowa analiza z MainWindow: osobne skalarne przebiegi po QJsonArray
+    static double legacyAnalyze(const QJsonArray &data) {
+        double minValue = std::numeric_limits<double>::max();
+        double maxValue = std::numeric_limits<double>::lowest();
+        double sum = 0.0;
+        int count = 0;
+        int exceedances = 0;
+        for (const QJsonValue &val : data) {
+            QJsonObject v = val.toObject();
+            if (!v["value"].isNull()) {
+                double value = v["value"].toDouble();
+                if (value < minValue) minValue = value;
+                if (value > maxValue) maxValue = value;
+                sum += value;
+                ++count;
+                if (value > 25.0) ++exceedances;
+            }
+        }
+        double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
+        int n = 0;
+        for (int i = 0; i < data.size(); ++i) {
+            QJsonObject v = data[i].toObject();
+            if (!v["value"].isNull()) {
+                double y = v["value"].toDouble();
+                sumX += i;
+                sumY += y;
+                sumXY += i * y;
+                sumXX += i * i;
+                n++;
+            }
+        }
+        return minValue + maxValue + sum + exceedances + (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+    }
+
+private slots:
+    void legacyJson_data() {
+        QTest::addColumn<int>("size");
+        QTest::newRow("1k") << 1000;
+        QTest::newRow("100k") << 100000;
+    }
+
+    void legacyJson() {
+        QFETCH(int, size);
+        const QJsonArray data = toJson(SyntheticData::series(size));
+        double result = 0.0;
+        QBENCHMARK {
+            result += legacyAnalyze(data);
+        }
+        QVERIFY(result != 0.0);
+    }
+
+    void kernel_data() {
+        QTest::addColumn<int>("isa");
+        QTest::addColumn<int>("size");
+        for (StatKernels::Isa isa : StatKernels::availableIsas()) {
+            for (int size : {1000, 100000, 10000000}) {
+                QTest::addRow("%s/%d", StatKernels::isaName(isa), size) << int(isa) << size;
+            }
+        }
+    }
+
+    void kernel() {
+        QFETCH(int, isa);
+        QFETCH(int, size);
+        const SeriesColumns series = SyntheticData::series(size);
+        SeriesMoments moments;
+        QBENCHMARK {
+            moments = StatKernels::computeWith(StatKernels::Isa(isa), series.timestamps(), series.values(),
+                                               series.validity(), 0, series.size(), series.timestamp(0), 25.0f);
+        }
+        QVERIFY(moments.count > 0);
+    }
+};
+
+int runBenchStatKernels(const QStringList &arguments)
+{
+    BenchStatKernels bench;
+    return QTest::qExec(&bench, arguments);
+}
+
+#include "bench_statkernels.moc"
@@ -0,0 +1,10 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <QStringList>
+
+// Uruchomienie jednej klasy benchmarków z argumentami QtTest (zwraca liczbę nieudanych testów)
+int runBenchStatKernels(const QStringList &arguments);
+int runBenchPipeline(const QStringList &arguments);
+
+#endif // BENCHMARKS_H
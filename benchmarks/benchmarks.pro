@@ -0,0 +1,19 @@
+QT       += testlib
+QT       -= gui
+
+# Bez "testcase": make check uruchamia tylko testy, nie wielominutowe benchmarki
+CONFIG += c++17 console
+CONFIG -= app_bundle
+TARGET = pogoda-benchmarks
+
+include(../core/core.pri)
+
+SOURCES += \
+    bench_pipeline.cpp \
+    bench_statkernels.cpp \
+    main.cpp \
+    syntheticdata.cpp
+
+HEADERS += \
+    benchmarks.h \
+    syntheticdata.h
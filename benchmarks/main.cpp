@@ -0,0 +1,49 @@
+#include <QCoreApplication>
+#include <QDir>
+#include "benchmarks.h"
+
+/*
+ * Uruchamia wszystkie klasy benchmarków po kolei. Argumenty QtTest są przekazywane dalej
+ * (np. -iterations, -minimumvalue, nazwy funkcji - wtedy razem z --suite <klasa>, bo QtTest
+ * kończy program przy nieznanej funkcji). Opcja --results <katalog> zapisuje dodatkowo
+ * wyniki każdej klasy do <katalog>/<klasa>.csv (format csv QtTest: nazwa, wiersz danych, metryka,
+ * wartość, iteracje), który można porównywać między przebiegami.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList arguments = app.arguments();
+    QString resultsDir;
+    const int resultsIndex = arguments.indexOf("--results");
+    if (resultsIndex > 0 && resultsIndex + 1 < arguments.size()) {
+        resultsDir = arguments.takeAt(resultsIndex + 1);
+        arguments.removeAt(resultsIndex);
+        QDir().mkpath(resultsDir);
+    }
+
+    QString onlySuite;
+    const int suiteIndex = arguments.indexOf("--suite");
+    if (suiteIndex > 0 && suiteIndex + 1 < arguments.size()) {
+        onlySuite = arguments.takeAt(suiteIndex + 1);
+        arguments.removeAt(suiteIndex);
+    }
+
+    const QList<QPair<QString, int (*)(const QStringList &)>> suites = {
+        {"BenchStatKernels", &runBenchStatKernels},
+        {"BenchPipeline", &runBenchPipeline}
+    };
+
+    int failures = 0;
+    for (const auto &suite : suites) {
+        if (!onlySuite.isEmpty() && suite.first != onlySuite)
+            continue;
+        QStringList suiteArguments = arguments;
+        if (!resultsDir.isEmpty()) {
+            suiteArguments << "-o" << QDir(resultsDir).filePath(suite.first + ".csv") + ",csv"
+                           << "-o" << "-,txt";
+        }
+        failures += suite.second(suiteArguments);
+    }
+    return failures;
+}
@@ -0,0 +1,140 @@
+#include "syntheticdata.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QtMath>
+
+namespace {
+
+const QStringList Provinces = {
+    "DOLNOŚLĄSKIE", "KUJAWSKO-POMORSKIE", "LUBELSKIE", "LUBUSKIE", "ŁÓDZKIE", "MAŁOPOLSKIE",
+    "MAZOWIECKIE", "OPOLSKIE", "PODKARPACKIE", "PODLASKIE", "POMORSKIE", "ŚLĄSKIE",
+    "ŚWIĘTOKRZYSKIE", "WARMIŃSKO-MAZURSKIE", "WIELKOPOLSKIE", "ZACHODNIOPOMORSKIE"
+};
+const QStringList CityStems = {
+    "Kraków", "Łódź", "Wrocław", "Poznań", "Gdańsk", "Szczecin", "Bydgoszcz", "Lublin",
+    "Białystok", "Katowice", "Gdynia", "Częstochowa", "Radom", "Toruń", "Kielce", "Rzeszów",
+    "Gliwice", "Zabrze", "Olsztyn", "Bielsko-Biała", "Bytom", "Zielona Góra", "Rybnik", "Tarnów"
+};
+const QStringList Streets = {
+    "Aleje Krasińskiego", "ul. Bulwarowa", "ul. Złota", "ul. Śląska", "os. Piastów",
+    "ul. Wróblewskiego", "ul. Żeromskiego", "ul. Kościuszki", "ul. Mickiewicza", "ul. Łączna"
+};
+const QStringList ParamCodes = {"PM10", "PM2.5", "NO2", "SO2", "O3", "CO", "C6H6"};
+
+// Miasta powtarzają się z numerem, żeby przy dużych katalogach nazwy nie były unikalne jak w realnych danych
+QString cityFor(int i)
+{
+    const QString stem = CityStems[i % CityStems.size()];
+    const int round = i / CityStems.size() / 8;
+    return round == 0 ? stem : QString("%1 %2").arg(stem).arg(round);
+}
+
+} // namespace
+
+QList<Station> SyntheticData::stations(int count, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+    QList<Station> result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Station station;
+        station.id = 100 + i;
+        station.cityName = cityFor(i);
+        station.name = QString("%1, %2").arg(station.cityName, Streets[rng.bounded(Streets.size())]);
+        station.communeName = station.cityName;
+        station.districtName = QString("powiat %1").arg(station.cityName);
+        station.provinceName = Provinces[i % Provinces.size()];
+        station.latitude = 49.0 + rng.bounded(5.8);
+        station.longitude = 14.1 + rng.bounded(10.0);
+        result.append(station);
+    }
+    return result;
+}
+
+QByteArray SyntheticData::stationsJson(int count, quint32 seed)
+{
+    QJsonArray array;
+    for (const Station &station : stations(count, seed)) {
+        QJsonObject commune;
+        commune["communeName"] = station.communeName;
+        commune["districtName"] = station.districtName;
+        commune["provinceName"] = station.provinceName;
+        QJsonObject city;
+        city["id"] = station.id;
+        city["name"] = station.cityName;
+        city["commune"] = commune;
+
+        QJsonObject obj;
+        obj["id"] = station.id;
+        obj["stationName"] = station.name;
+        obj["gegrLat"] = QString::number(station.latitude, 'f', 6);
+        obj["gegrLon"] = QString::number(station.longitude, 'f', 6);
+        obj["city"] = city;
+        obj["addressStreet"] = QJsonValue::Null;
+        array.append(obj);
+    }
+    return QJsonDocument(array).toJson(QJsonDocument::Compact);
+}
+
+QByteArray SyntheticData::sensorsJson(int stationId, int count)
+{
+    QJsonArray array;
+    for (int i = 0; i < count; ++i) {
+        const QString code = paramCode(i);
+        QJsonObject param;
+        param["paramName"] = QString("parametr %1").arg(code);
+        param["paramFormula"] = code;
+        param["paramCode"] = code;
+        param["idParam"] = i + 1;
+
+        QJsonObject obj;
+        obj["id"] = sensorId(stationId, i);
+        obj["stationId"] = stationId;
+        obj["param"] = param;
+        array.append(obj);
+    }
+    return QJsonDocument(array).toJson(QJsonDocument::Compact);
+}
+
+QByteArray SyntheticData::measurementsJson(const QString &paramCode, int points, quint32 seed, qint64 start)
+{
+    const SeriesColumns columns = series(points, seed, start);
+    QJsonArray values;
+    // API zwraca pomiary od najnowszego
+    for (qsizetype i = columns.size() - 1; i >= 0; --i) {
+        QJsonObject v;
+        v["date"] = QDateTime::fromMSecsSinceEpoch(columns.timestamp(i)).toString("yyyy-MM-dd HH:mm:ss");
+        v["value"] = columns.isValid(i) ? QJsonValue(columns.value(i)) : QJsonValue(QJsonValue::Null);
+        values.append(v);
+    }
+    QJsonObject obj;
+    obj["key"] = paramCode;
+    obj["values"] = values;
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
+SeriesColumns SyntheticData::series(int points, quint32 seed, qint64 start)
+{
+    QRandomGenerator rng(seed);
+    SeriesColumns columns;
+    columns.reserve(points);
+    for (int i = 0; i < points; ++i) {
+        // Dobowy cykl z szumem, jak stężenia pyłów
+        const double daily = 30.0 + 15.0 * std::sin(i * 2.0 * M_PI / 24.0);
+        columns.append(start + qint64(i) * 3600 * 1000, float(daily + rng.bounded(50.0)), rng.bounded(10) != 0);
+    }
+    return columns;
+}
+
+QString SyntheticData::paramCode(int index)
+{
+    return ParamCodes[index % ParamCodes.size()];
+}
+
+qint64 SyntheticData::seriesStart()
+{
+    return QDateTime(QDate(2023, 1, 1), QTime(0, 0)).toMSecsSinceEpoch();
+}
@@ -0,0 +1,37 @@
+#ifndef SYNTHETICDATA_H
+#define SYNTHETICDATA_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include "giosdata.h"
+#include "seriesstore.h"
+
+/**
+ * @brief Deterministyczne dane testowe w skali GIOŚ.
+ * @details Odpowiedzi mają układ pól API (station/findAll, station/sensors, data/getData),
+ * nazwy z polskimi znakami, a serie godzinowe ok. 10% brakujących odczytów.
+ * Ten sam seed daje zawsze te same dane, więc wyniki kolejnych przebiegów są porównywalne.
+ */
+namespace SyntheticData
+{
+qint64 seriesStart();
+
+QList<Station> stations(int count, quint32 seed = 42);
+QByteArray stationsJson(int count, quint32 seed = 42);
+QByteArray sensorsJson(int stationId, int count);
+QByteArray measurementsJson(const QString &paramCode, int points, quint32 seed = 42, qint64 start = seriesStart());
+
+SeriesColumns series(int points, quint32 seed = 42, qint64 start = seriesStart());
+
+/**
+ * @brief Kod parametru i-tego czujnika stacji w sensorsJson.
+ */
+QString paramCode(int index);
+/**
+ * @brief ID czujnika w sensorsJson; stacja i indeks czujnika dają się z niego odtworzyć.
+ */
+inline int sensorId(int stationId, int index) { return stationId * 100 + index; }
+}
+
+#endif // SYNTHETICDATA_H
@@ -0,0 +1,359 @@
+#include "apimanager.h"
+#include "asyncwriter.h"
+#include "bulkcrawler.h"
+#include "measurementarchive.h"
+#include "regionreport.h"
+#include "seriesanalysis.h"
+#include "seriesexport.h"
+#include "seriesrollup.h"
+#include "stationgeoindex.h"
+#include "stationsnapshot.h"
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QTextStream>
+#include <QTimer>
+#include <QUrl>
+#include <QDebug>
+#include <algorithm>
+
+static QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+static void printStats(const BulkCrawler::Stats &stats)
+{
+    out() << QString("stacje %1/%2, czujniki %3/%4, błędy %5, %6 żądań/s, %7 odebranych pomiarów/s\n")
+                 .arg(stats.sensorListsDone).arg(stats.stations)
+                 .arg(stats.sensorsDone).arg(stats.sensorsTotal)
+                 .arg(stats.failures)
+                 .arg(stats.requestsPerSecond(), 0, 'f', 1)
+                 .arg(stats.pointsPerSecond(), 0, 'f', 0);
+    out().flush();
+}
+
+// Błędy wątku zapisu są wypisywane od razu, z wątku zapisu (qWarning jest bezpieczne wątkowo)
+static void reportWriteFailures()
+{
+    QObject::connect(&AsyncWriter::instance(), &AsyncWriter::writeFailed, [](const QString &path, const QString &error) {
+        qWarning() << "Błąd zapisu" << path << ":" << error;
+    });
+}
+
+// Zapis śladu Chrome trace-event, gdy podano --trace
+static void writeTrace(const QCommandLineParser &parser)
+{
+    if (!parser.isSet("trace"))
+        return;
+    QString error;
+    if (!Tracer::instance().writeChromeTrace(parser.value("trace"), &error))
+        qWarning() << "Nie udało się zapisać śladu:" << error;
+}
+
+// Zakres --from/--to w ms od epoki; brakujące granice pozostają bez zmian.
+// Literówka w dacie nie może po cichu stać się rokiem 1970 - zwraca false po komunikacie
+static bool readRange(const QCommandLineParser &parser, qint64 *from, qint64 *to)
+{
+    const struct { const char *name; qint64 *target; } bounds[] = {{"from", from}, {"to", to}};
+    for (const auto &bound : bounds) {
+        if (!parser.isSet(bound.name))
+            continue;
+        const QDateTime dt = QDateTime::fromString(parser.value(bound.name), Qt::ISODate);
+        if (!dt.isValid()) {
+            qWarning() << "Nieprawidłowa data" << QString("--%1:").arg(bound.name) << parser.value(bound.name);
+            return false;
+        }
+        *bound.target = dt.toMSecsSinceEpoch();
+    }
+    return true;
+}
+
+// Jednorazowe pobranie wszystkich stacji i czujników do archiwum
+static int runCrawl(QCoreApplication &app, const QCommandLineParser &parser)
+{
+    MeasurementArchive archive(parser.value("archive"));
+    BulkCrawler crawler(&ApiManager::instance(), &archive);
+    crawler.setConcurrency(parser.value("concurrency").toInt());
+
+    QObject::connect(&crawler, &BulkCrawler::progress, &printStats);
+    QObject::connect(&crawler, &BulkCrawler::failed, [](RequestKind, int stationId, int sensorId, const QString &error) {
+        qWarning() << "Błąd pobierania, stacja" << stationId << "czujnik" << sensorId << ":" << error;
+    });
+    reportWriteFailures();
+    // Licznik wątku zapisu jest aktualny po finished (crawler opróżnia kolejkę), w przeciwieństwie
+    // do zakolejkowanych jeszcze sygnałów writeFailed
+    const qint64 writeFailuresBefore = AsyncWriter::instance().stats().failures;
+    QObject::connect(&crawler, &BulkCrawler::finished, &app, [&app, writeFailuresBefore](const BulkCrawler::Stats &stats) {
+        const qint64 writeFailures = AsyncWriter::instance().stats().failures - writeFailuresBefore;
+        if (writeFailures > 0)
+            qWarning() << "Nieudane zapisy:" << writeFailures;
+        app.exit(stats.failures == 0 && writeFailures == 0 ? 0 : 1);
+    });
+
+    crawler.start();
+    return app.exec();
+}
+
+// Tryb demona: pełne pobranie co zadany interwał, liczony od startu poprzedniego przebiegu
+static int runDaemon(QCoreApplication &app, const QCommandLineParser &parser)
+{
+    MeasurementArchive archive(parser.value("archive"));
+    BulkCrawler crawler(&ApiManager::instance(), &archive);
+    crawler.setConcurrency(parser.value("concurrency").toInt());
+    const qint64 intervalMs = qMax(1, parser.value("interval").toInt()) * 60 * 1000;
+
+    reportWriteFailures();
+    QObject::connect(&crawler, &BulkCrawler::failed, [](RequestKind, int stationId, int sensorId, const QString &error) {
+        qWarning() << "Błąd pobierania, stacja" << stationId << "czujnik" << sensorId << ":" << error;
+    });
+    QObject::connect(&crawler, &BulkCrawler::finished, &app, [&crawler, &parser, intervalMs](const BulkCrawler::Stats &stats) {
+        out() << QDateTime::currentDateTime().toString(Qt::ISODate) << " przebieg zakończony: ";
+        printStats(stats);
+        // Plik śladu obejmuje ostatni przebieg; liczniki i histogramy sumują się przez cały czas działania
+        writeTrace(parser);
+        Tracer::instance().clearEvents();
+        const qint64 delay = qMax<qint64>(0, intervalMs - stats.elapsedMs);
+        QTimer::singleShot(delay, &crawler, &BulkCrawler::start);
+    });
+
+    crawler.start();
+    return app.exec();
+}
+
+// Analiza serii zapisanej w archiwum, bez pobierania danych
+static int runAnalyze(const QCommandLineParser &parser)
+{
+    if (!parser.isSet("station") || !parser.isSet("param")) {
+        qWarning() << "Polecenie analyze wymaga --station i --param";
+        return 2;
+    }
+
+    const MeasurementArchive archive(parser.value("archive"));
+    const SeriesKey key{parser.value("station").toInt(), parser.value("param")};
+
+    qint64 from = std::numeric_limits<qint64>::min();
+    qint64 to = std::numeric_limits<qint64>::max();
+    if (!readRange(parser, &from, &to))
+        return 2;
+
+    const SeriesColumns series = archive.read(key, from, to);
+    out() << SeriesAnalysis::format(SeriesAnalysis::analyze(key.paramCode, series));
+
+    if (parser.isSet("rollup")) {
+        const QString name = parser.value("rollup");
+        const RollupLevel level = name == "monthly" ? RollupLevel::Monthly : RollupLevel::Daily;
+        SeriesRollup rollup;
+        rollup.rebuild(series);
+        const QString format = level == RollupLevel::Monthly ? "yyyy-MM" : "yyyy-MM-dd";
+        for (const RollupBucket &bucket : rollup.buckets(level)) {
+            out() << QDateTime::fromMSecsSinceEpoch(bucket.start).toString(format)
+                  << "\t" << bucket.count
+                  << "\t" << QString::number(bucket.min, 'f', 2)
+                  << "\t" << QString::number(bucket.mean(), 'f', 2)
+                  << "\t" << QString::number(bucket.max, 'f', 2) << "\n";
+        }
+    }
+    out().flush();
+    return 0;
+}
+
+// Najbliższe stacje względem punktu, z katalogu stacji (pamięć podręczna HTTP lub API)
+static int runNearest(QCoreApplication &app, const QCommandLineParser &parser)
+{
+    if (!parser.isSet("lat") || !parser.isSet("lon")) {
+        qWarning() << "Polecenie nearest wymaga --lat i --lon";
+        return 2;
+    }
+
+    const double latitude = parser.value("lat").toDouble();
+    const double longitude = parser.value("lon").toDouble();
+    ApiManager &api = ApiManager::instance();
+    QObject::connect(&api, &ApiManager::stationsReceived, &app, [&](const QList<Station> &stations) {
+        StationGeoIndex index;
+        index.build(stations);
+        const QVector<StationGeoIndex::Hit> hits = parser.isSet("radius")
+            ? index.within(latitude, longitude, parser.value("radius").toDouble())
+            : index.nearest(latitude, longitude, parser.value("count").toInt());
+        for (const StationGeoIndex::Hit &hit : hits) {
+            const Station &station = stations[hit.row];
+            out() << station.id << "\t" << QString::number(hit.distanceKm, 'f', 2) << " km\t"
+                  << station.name << "\n";
+        }
+        out().flush();
+        app.exit(0);
+    });
+    QObject::connect(&api, &ApiManager::requestFailed, &app, [&app](RequestKind, int, int, const QString &error) {
+        qWarning() << "Nie udało się pobrać listy stacji:" << error;
+        app.exit(1);
+    });
+
+    api.getAirStations();
+    return app.exec();
+}
+
+// Raport regionalny dla jednego parametru: katalog stacji z API, serie z archiwum
+static int runReport(QCoreApplication &app, const QCommandLineParser &parser)
+{
+    if (!parser.isSet("param")) {
+        qWarning() << "Polecenie report wymaga --param";
+        return 2;
+    }
+
+    const QString levelName = parser.value("level");
+    const RegionLevel level = levelName == "district" ? RegionLevel::District
+                              : levelName == "commune" ? RegionLevel::Commune : RegionLevel::Province;
+    const QString paramCode = parser.value("param");
+    qint64 from = std::numeric_limits<qint64>::min();
+    qint64 to = std::numeric_limits<qint64>::max();
+    if (!readRange(parser, &from, &to))
+        return 2;
+
+    const MeasurementArchive archive(parser.value("archive"));
+    ApiManager &api = ApiManager::instance();
+    QObject::connect(&api, &ApiManager::stationsReceived, &app, [&](const QList<Station> &stations) {
+        QElapsedTimer timer;
+        timer.start();
+        const QList<RegionRow> rows = RegionReport::compute(stations, paramCode, level,
+            [&archive](const SeriesKey &key, qint64 rangeFrom, qint64 rangeTo) {
+                return archive.read(key, rangeFrom, rangeTo);
+            }, from, to);
+        out() << RegionReport::format(paramCode, level, rows);
+        out() << "Czas obliczeń: " << timer.elapsed() << " ms\n";
+        out().flush();
+        app.exit(0);
+    });
+    QObject::connect(&api, &ApiManager::requestFailed, &app, [&app](RequestKind, int, int, const QString &error) {
+        qWarning() << "Nie udało się pobrać listy stacji:" << error;
+        app.exit(1);
+    });
+
+    api.getAirStations();
+    return app.exec();
+}
+
+// Eksport serii z archiwum do CSV lub formatu binarnego, strumieniowo
+static int runExport(const QCommandLineParser &parser)
+{
+    if (!parser.isSet("out")) {
+        qWarning() << "Polecenie export wymaga --out";
+        return 2;
+    }
+
+    ExportOptions options;
+    options.path = parser.value("out");
+    const QString layout = parser.value("layout");
+    options.layout = layout == "wide" ? ExportOptions::Layout::WideCsv
+                     : layout == "binary" ? ExportOptions::Layout::Binary : ExportOptions::Layout::LongCsv;
+    const QString compression = parser.value("compress");
+    options.compression = compression == "gzip" ? ExportOptions::Compression::Gzip
+                          : compression == "zstd" ? ExportOptions::Compression::Zstd
+                                                  : ExportOptions::Compression::None;
+    if (!SeriesExporter::isSupported(options.compression)) {
+        qWarning() << "Kompresja" << compression << "nie jest dostępna w tej kompilacji";
+        return 2;
+    }
+    if (!readRange(parser, &options.from, &options.to))
+        return 2;
+
+    QSet<int> stationIds;
+    for (const QString &id : parser.value("station").split(',', Qt::SkipEmptyParts))
+        stationIds.insert(id.toInt());
+    const QStringList params = parser.value("param").split(',', Qt::SkipEmptyParts);
+
+    const MeasurementArchive archive(parser.value("archive"));
+    for (const SeriesKey &key : archive.keys()) {
+        if ((stationIds.isEmpty() || stationIds.contains(key.stationId))
+            && (params.isEmpty() || params.contains(key.paramCode)))
+            options.keys.append(key);
+    }
+    std::sort(options.keys.begin(), options.keys.end(), [](const SeriesKey &a, const SeriesKey &b) {
+        return a.stationId != b.stationId ? a.stationId < b.stationId : a.paramCode < b.paramCode;
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    const QString error = SeriesExporter::run(options, [&archive](const SeriesKey &key, qint64 from, qint64 to) {
+        return archive.read(key, from, to);
+    });
+    if (!error.isEmpty()) {
+        qWarning() << "Eksport nie powiódł się:" << error;
+        return 1;
+    }
+    out() << "Wyeksportowano " << options.keys.size() << " serii do " << options.path
+          << " w " << timer.elapsed() << " ms\n";
+    out().flush();
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("pogoda-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Pobieranie i analiza danych GIOŚ bez interfejsu graficznego.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("polecenie", "crawl | daemon | analyze | nearest | report | export");
+    parser.addOption({"archive", "Katalog archiwum pomiarów.", "dir", "archiwum"});
+    parser.addOption({"base-url", "Adres bazowy REST API (domyślnie GIOS_API_URL lub serwer GIOŚ).", "url"});
+    parser.addOption({"concurrency", "Maksymalna liczba jednoczesnych żądań.", "n", "8"});
+    parser.addOption({"interval", "Odstęp między przebiegami demona w minutach.", "min", "60"});
+    parser.addOption({"station", "ID stacji (analyze); lista po przecinku (export).", "id"});
+    parser.addOption({"param", "Kod parametru, np. PM10 (analyze, report); lista po przecinku (export).", "kod"});
+    parser.addOption({"from", "Początek zakresu, ISO 8601 (analyze, report, export).", "data"});
+    parser.addOption({"to", "Koniec zakresu, ISO 8601 (analyze, report, export).", "data"});
+    parser.addOption({"level", "Grupowanie: province | district | commune (report).", "poziom", "province"});
+    parser.addOption({"lat", "Szerokość geograficzna punktu (nearest).", "stopnie"});
+    parser.addOption({"lon", "Długość geograficzna punktu (nearest).", "stopnie"});
+    parser.addOption({"count", "Liczba najbliższych stacji (nearest).", "n", "5"});
+    parser.addOption({"radius", "Zamiast count: wszystkie stacje w promieniu (nearest).", "km"});
+    parser.addOption({"rollup", "Zestawienie dobowe lub miesięczne: daily | monthly (analyze).", "poziom"});
+    parser.addOption({"out", "Plik wynikowy (export).", "plik"});
+    parser.addOption({"layout", "Układ pliku: long | wide | binary (export).", "układ", "long"});
+    parser.addOption({"compress", "Kompresja: none | gzip | zstd (export).", "metoda", "none"});
+    parser.addOption({"trace", "Włącza śledzenie i zapisuje ślad Chrome trace-event (demon: po każdym przebiegu).", "plik"});
+    parser.addOption({"metrics-interval", "Włącza śledzenie i co zadany czas wypisuje liczniki i histogramy.", "s", "0"});
+    parser.process(app);
+    if (parser.isSet("base-url"))
+        ApiManager::instance().setBaseUrl(QUrl(parser.value("base-url")));
+    // Bez GUI odczyt nagłówka migawki może blokować; niezmieniony katalog nie będzie zapisany ponownie
+    ApiManager::instance().setSavedStationsHash(StationSnapshot::storedHash());
+
+    const int metricsInterval = parser.value("metrics-interval").toInt();
+    if (parser.isSet("trace") || metricsInterval > 0)
+        Tracer::setEnabled(true);
+    QTimer metricsTimer;
+    QObject::connect(&metricsTimer, &QTimer::timeout, []() {
+        out() << "--- " << QDateTime::currentDateTime().toString(Qt::ISODate) << " metryki\n"
+              << Tracer::instance().metricsText();
+        out().flush();
+    });
+    if (metricsInterval > 0)
+        metricsTimer.start(metricsInterval * 1000);
+
+    const QString command = parser.positionalArguments().value(0);
+    int result = 0;
+    if (command == "crawl")
+        result = runCrawl(app, parser);
+    else if (command == "daemon")
+        result = runDaemon(app, parser);
+    else if (command == "analyze")
+        result = runAnalyze(parser);
+    else if (command == "nearest")
+        result = runNearest(app, parser);
+    else if (command == "report")
+        result = runReport(app, parser);
+    else if (command == "export")
+        result = runExport(parser);
+    else
+        parser.showHelp(1);
+
+    writeTrace(parser);
+    return result;
+}
@@ -0,0 +1,38 @@
+#include "analysisservice.h"
+#include <QtConcurrent>
+
+AnalysisService::AnalysisService(QObject *parent)
+    : QObject(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<AnalysisResult>::resultReadyAt, this, [this](int index) {
+        emit resultReady(index, m_watcher.resultAt(index));
+    });
+    connect(&m_watcher, &QFutureWatcher<AnalysisResult>::progressValueChanged, this, [this](int value) {
+        emit progress(value, m_watcher.progressMaximum());
+    });
+    connect(&m_watcher, &QFutureWatcher<AnalysisResult>::finished, this, [this]() {
+        emit finished(m_watcher.isCanceled());
+    });
+}
+
+AnalysisService::~AnalysisService()
+{
+    m_watcher.cancel();
+    m_watcher.waitForFinished();
+}
+
+void AnalysisService::start(const QList<Job> &jobs)
+{
+    cancel();
+    m_watcher.setFuture(QtConcurrent::mapped(jobs, [](const Job &job) {
+        if (!job.aggregate.isEmpty())
+            return SeriesAnalysis::fromAggregate(job.paramCode, job.aggregate);
+        return SeriesAnalysis::analyze(job.paramCode, job.series);
+    }));
+}
+
+void AnalysisService::cancel()
+{
+    if (m_watcher.isRunning())
+        m_watcher.cancel();
+}
@@ -0,0 +1,49 @@
+#ifndef ANALYSISSERVICE_H
+#define ANALYSISSERVICE_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include "seriesanalysis.h"
+
+/**
+ * @brief Asynchroniczna analiza serii pomiarowych w puli wątków.
+ * @details Zadania pracują na niezmiennych migawkach serii (SeriesColumns współdzieli dane
+ * bez kopiowania), więc wątki robocze nie sięgają do magazynu ani do widżetów.
+ * Wyniki są zgłaszane po kolei, w miarę kończenia się poszczególnych parametrów;
+ * pętla zdarzeń nigdy nie jest blokowana.
+ */
+class AnalysisService : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Pojedyncze zadanie: kod parametru i migawka jego serii.
+     * @details Gdy podano niepusty agregat z magazynu, wynik powstaje z niego bez skanowania serii.
+     */
+    struct Job {
+        QString paramCode;
+        SeriesColumns series;
+        RunningAggregate aggregate = RunningAggregate();
+    };
+
+    explicit AnalysisService(QObject *parent = nullptr);
+    ~AnalysisService();
+
+    /**
+     * @brief Rozpoczyna analizę; trwająca wcześniej analiza jest anulowana.
+     * @param jobs Zadania do wykonania.
+     */
+    void start(const QList<Job> &jobs);
+    void cancel();
+    bool isRunning() const { return m_watcher.isRunning(); }
+
+signals:
+    void resultReady(int jobIndex, const AnalysisResult &result);
+    void progress(int done, int total);
+    void finished(bool cancelled);
+
+private:
+    QFutureWatcher<AnalysisResult> m_watcher;
+};
+
+#endif // ANALYSISSERVICE_H
@@ -0,0 +1,56 @@
+#include "apicache.h"
+#include <QStandardPaths>
+#include <QUrl>
+
+namespace {
+
+constexpr qint64 StationTtlSecs = 24 * 60 * 60;    // Lista stacji i czujników zmienia się rzadko
+
+} // namespace
+
+ApiCache::ApiCache(QObject *parent)
+    : QNetworkDiskCache(parent)
+{
+    setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/http");
+    setMaximumCacheSize(200 * 1024 * 1024);
+}
+
+QIODevice *ApiCache::prepare(const QNetworkCacheMetaData &metaData)
+{
+    return QNetworkDiskCache::prepare(withTtl(metaData));
+}
+
+void ApiCache::updateMetaData(const QNetworkCacheMetaData &metaData)
+{
+    // Wywoływane m.in. po odpowiedzi 304 na żądanie warunkowe
+    QNetworkDiskCache::updateMetaData(withTtl(metaData));
+}
+
+QDateTime ApiCache::expirationFor(const QUrl &url, const QDateTime &now)
+{
+    const QString path = url.path();
+    if (path.contains("/data/getData/")) {
+        // Nowe dane pojawiają się co godzinę - wpis wygasa na początku następnej godziny
+        QDateTime hour = now;
+        hour.setTime(QTime(now.time().hour(), 0));
+        return hour.addSecs(60 * 60);
+    }
+    if (path.contains("/station/findAll") || path.contains("/station/sensors/"))
+        return now.addSecs(StationTtlSecs);
+    return now;
+}
+
+QNetworkCacheMetaData ApiCache::withTtl(QNetworkCacheMetaData metaData)
+{
+    // Serwer może zabraniać cache'owania; zachowujemy tylko nagłówki potrzebne do rewalidacji
+    QNetworkCacheMetaData::RawHeaderList headers;
+    for (const QNetworkCacheMetaData::RawHeader &header : metaData.rawHeaders()) {
+        const QByteArray name = header.first.toLower();
+        if (name != "cache-control" && name != "pragma" && name != "expires")
+            headers.append(header);
+    }
+    metaData.setRawHeaders(headers);
+    metaData.setSaveToDisk(true);
+    metaData.setExpirationDate(expirationFor(metaData.url()));
+    return metaData;
+}
@@ -0,0 +1,29 @@
+#ifndef APICACHE_H
+#define APICACHE_H
+
+#include <QNetworkDiskCache>
+#include <QDateTime>
+
+/**
+ * @brief Dyskowa pamięć podręczna odpowiedzi API GIOŚ.
+ * @details Nadaje każdemu endpointowi własny czas ważności (TTL) niezależnie od nagłówków serwera:
+ * długi dla station/findAll i station/sensors, a dla data/getData - do najbliższej pełnej godziny,
+ * bo GIOŚ publikuje nowe pomiary raz na godzinę. Po wygaśnięciu wpisu QNetworkAccessManager
+ * wysyła żądanie warunkowe (If-None-Match / If-Modified-Since), jeśli serwer podał ETag lub Last-Modified.
+ */
+class ApiCache : public QNetworkDiskCache
+{
+    Q_OBJECT
+public:
+    explicit ApiCache(QObject *parent = nullptr);
+
+    QIODevice *prepare(const QNetworkCacheMetaData &metaData) override;
+    void updateMetaData(const QNetworkCacheMetaData &metaData) override;
+
+    static QDateTime expirationFor(const QUrl &url, const QDateTime &now = QDateTime::currentDateTimeUtc());
+
+private:
+    static QNetworkCacheMetaData withTtl(QNetworkCacheMetaData metaData);
+};
+
+#endif // APICACHE_H
@@ -0,0 +1,331 @@
+#include "apimanager.h"
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QUrl>
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDateTime>
+#include "giosparser.h"
+#include "apicache.h"
+#include "tracer.h"
+#include "asyncwriter.h"
+#include "stationsnapshot.h"
+
+ApiManager::ApiManager(QObject *parent)
+    : QObject(parent),
+    manager(new QNetworkAccessManager(this))
+{
+    setBaseUrl(defaultBaseUrl());
+    cache = new ApiCache(manager);
+    manager->setCache(cache);
+    connect(manager, &QNetworkAccessManager::finished,
+            this, &ApiManager::onReplyFinished);
+    // Nieudany (lub odrzucony) zapis migawki: skrót jest nieznany, więc kolejne pobranie ponowi zapis
+    connect(&AsyncWriter::instance(), &AsyncWriter::writeFailed, this, [this](const QString &path) {
+        if (path == QLatin1String(StationSnapshot::DefaultPath))
+            m_savedStationsHash = 0;
+    });
+    // Gdy dysk nie nadąża, nowe żądania czekają w kolejkach, zamiast zasypywać wątek zapisu danymi
+    m_writerCongested = AsyncWriter::instance().isCongested();
+    connect(&AsyncWriter::instance(), &AsyncWriter::congestionChanged, this, [this](bool congested) {
+        m_writerCongested = congested;
+        if (!congested)
+            dispatch();
+    });
+}
+
+ApiManager &ApiManager::instance()
+{
+    static ApiManager manager;
+    return manager;
+}
+
+void ApiManager::getAirStations(RequestPriority priority)
+{
+    enqueue(endpoint("station/findAll"), RequestKind::Stations, priority, 0, 0);
+}
+
+QUrl ApiManager::defaultBaseUrl()
+{
+    const QString fromEnvironment = qEnvironmentVariable("GIOS_API_URL");
+    return QUrl(fromEnvironment.isEmpty() ? QString("https://api.gios.gov.pl/pjp-api/rest/") : fromEnvironment);
+}
+
+void ApiManager::setBaseUrl(const QUrl &url)
+{
+    // Ścieżki endpointów są rozwiązywane względem bazy, więc musi się ona kończyć ukośnikiem
+    m_baseUrl = url;
+    if (!m_baseUrl.path().endsWith('/'))
+        m_baseUrl.setPath(m_baseUrl.path() + '/');
+}
+
+QUrl ApiManager::endpoint(const QString &path) const
+{
+    return m_baseUrl.resolved(QUrl(path));
+}
+
+ApiManager::CacheStats ApiManager::cacheStats() const
+{
+    CacheStats stats;
+    stats.hits = m_cacheHits;
+    stats.misses = m_cacheMisses;
+    stats.revalidations = m_cacheRevalidations;
+    stats.sizeBytes = cache->cacheSize();
+    return stats;
+}
+
+void ApiManager::setMaxInFlight(int count)
+{
+    m_maxInFlight = qMax(1, count);
+    dispatch();
+}
+
+int ApiManager::pendingCount() const
+{
+    int count = 0;
+    for (const QQueue<QNetworkRequest> &queue : m_queues)
+        count += queue.size();
+    return count;
+}
+
+void ApiManager::cancelStation(int stationId)
+{
+    for (QQueue<QNetworkRequest> &queue : m_queues) {
+        queue.removeIf([stationId](const QNetworkRequest &request) {
+            return request.attribute(StationIdAttribute).toInt() == stationId;
+        });
+    }
+
+    // abort() od razu emituje finished, więc zbieramy odpowiedzi przed przerwaniem
+    QList<QNetworkReply *> toAbort;
+    for (QNetworkReply *reply : std::as_const(m_inFlight)) {
+        if (reply->request().attribute(StationIdAttribute).toInt() == stationId)
+            toAbort << reply;
+    }
+    for (QNetworkReply *reply : toAbort)
+        reply->abort();
+}
+
+void ApiManager::enqueue(const QUrl &url, RequestKind kind, RequestPriority priority, int stationId, int sensorId)
+{
+    QNetworkRequest request(url);
+    // Świeży wpis z cache jest używany bez sieci, przeterminowany - rewalidowany żądaniem warunkowym
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+    request.setAttribute(KindAttribute, static_cast<int>(kind));
+    request.setAttribute(PriorityAttribute, static_cast<int>(priority));
+    request.setAttribute(StationIdAttribute, stationId);
+    request.setAttribute(SensorIdAttribute, sensorId);
+    if (Tracer::isEnabled())
+        request.setAttribute(QueuedAtAttribute, Tracer::now());
+    m_queues[static_cast<int>(priority)].enqueue(request);
+    dispatch();
+}
+
+QUrl ApiManager::dataUrl(int sensorId) const
+{
+    return endpoint(QString("data/getData/%1").arg(sensorId));
+}
+
+void ApiManager::setPaused(bool paused)
+{
+    if (m_paused == paused)
+        return;
+    m_paused = paused;
+    if (!m_paused)
+        dispatch();
+}
+
+void ApiManager::dispatch()
+{
+    while (!m_paused && !m_writerCongested && m_inFlight.size() < m_maxInFlight) {
+        QQueue<QNetworkRequest> *queue = nullptr;
+        for (QQueue<QNetworkRequest> &candidate : m_queues) {
+            if (!candidate.isEmpty()) {
+                queue = &candidate;
+                break;
+            }
+        }
+        if (!queue)
+            return;
+
+        QNetworkReply *reply = manager->get(queue->dequeue());   // odpowiedź wróci do onReplyFinished
+        m_inFlight.insert(reply);
+        // Świeży wpis z cache nie wysyła żądania; odpowiedź z cache po wysłaniu to rewalidacja (304)
+        connect(reply, &QNetworkReply::requestSent, reply, [reply]() {
+            reply->setProperty("sentToNetwork", true);
+        });
+        if (Tracer::isEnabled()) {
+            reply->setProperty("traceSentAt", Tracer::now());
+            connect(reply, &QNetworkReply::readyRead, reply, [reply]() {
+                if (!reply->property("traceFirstByteAt").isValid())
+                    reply->setProperty("traceFirstByteAt", Tracer::now());
+            });
+        }
+    }
+}
+
+/*
+void ApiManager::onReplyFinished(QNetworkReply *reply)
+{
+    if (reply->error() != QNetworkReply::NoError) {
+        qDebug() << "Błąd pobierania:" << reply->errorString();
+        reply->deleteLater();
+        return;
+    }
+
+    QString data = reply->readAll();
+
+    // Zapis do pliku JSON
+    QFile file("stacje.json");
+    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QTextStream out(&file);
+        out << data;
+        file.close();
+        qDebug() << "Dane zapisane do stacje.json";
+    } else {
+        qDebug() << "Nie udało się zapisać pliku";
+    }
+
+    emit apiReplyReceived(data);  // wyślij do GUI
+    reply->deleteLater();
+}
+*/
+//Zamieniamy treść tej funkcji z powodu jej nadpisywania danych pomiarowych do pliku stacje.json, co usuwa nasze dane o stacjach
+//Odpowiedź jest parsowana tylko raz, prosto z QByteArray, a do GUI trafiają gotowe struktury.
+//Typ odpowiedzi, ID stacji i ID czujnika niesie samo żądanie (atrybuty), więc nie zgadujemy po treści.
+void ApiManager::onReplyFinished(QNetworkReply *reply)
+{
+    m_inFlight.remove(reply);
+    // Zwolnione miejsce od razu oddajemy kolejnemu żądaniu z kolejki
+    dispatch();
+
+    const QNetworkRequest &request = reply->request();
+    const RequestKind kind = static_cast<RequestKind>(request.attribute(KindAttribute).toInt());
+    const RequestPriority priority = static_cast<RequestPriority>(request.attribute(PriorityAttribute).toInt());
+    const int stationId = request.attribute(StationIdAttribute).toInt();
+    const int sensorId = request.attribute(SensorIdAttribute).toInt();
+    if (Tracer::isEnabled())
+        traceReply(reply, kind);
+
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        // Żądanie anulowane przez cancelStation - wynik nikogo już nie interesuje
+        reply->deleteLater();
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        qDebug() << "Błąd pobierania:" << reply->errorString();
+        emit requestFailed(kind, stationId, sensorId, reply->errorString());
+        reply->deleteLater();
+        return;
+    }
+
+    if (reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+        ++m_cacheHits;
+        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304
+            || reply->property("sentToNetwork").toBool())
+            ++m_cacheRevalidations;
+    } else {
+        ++m_cacheMisses;
+    }
+
+    const QByteArray data = reply->readAll();
+    reply->deleteLater();
+
+    QString error;
+    switch (kind) {
+    case RequestKind::Stations: {
+        QList<Station> stations;
+        if (!GiosParser::parseStations(data, stations, &error))
+            break;
+        // Migawka katalogu do szybkiego startu zamiast surowego JSON; niezmieniony katalog nie jest
+        // zapisywany ponownie, więc plik otwarty przez mmap w innym miejscu nie jest podmieniany bez potrzeby.
+        // Skrót zapisanej migawki pochodzi z pamięci (setSavedStationsHash), bez odczytu dysku w tym wątku
+        const QByteArray snapshot = StationSnapshot::serialize(stations, QDateTime::currentMSecsSinceEpoch());
+        m_stationsHash = StationSnapshot::contentHash(snapshot);
+        if (m_stationsHash != m_savedStationsHash) {
+            saveReply(StationSnapshot::DefaultPath, snapshot);
+            m_savedStationsHash = m_stationsHash;
+        }
+        emit stationsReceived(stations);
+        return;
+    }
+    case RequestKind::Sensors: {
+        QList<Sensor> sensors;
+        if (!GiosParser::parseSensors(data, sensors, &error))
+            break;
+        for (const Sensor &sensor : sensors) {
+            // Dane czujników dziedziczą priorytet i stację po liście czujników
+            enqueue(dataUrl(sensor.id), RequestKind::Data, priority, stationId, sensor.id);
+        }
+        emit sensorsReceived(stationId, sensors);
+        return;
+    }
+    case RequestKind::Data: {
+        MeasurementSeries series;
+        if (!GiosParser::parseMeasurements(data, series, &error))
+            break;
+        series.stationId = stationId;
+        series.sensorId = sensorId;
+        emit measurementsReceived(series);
+        return;
+    }
+    }
+
+    qDebug() << "Nie udało się sparsować JSON:" << error;
+    emit requestFailed(kind, stationId, sensorId, error);
+}
+
+// Etapy żądania (w kolejce, oczekiwanie na pierwszy bajt, pobieranie), liczniki i histogram per endpoint
+void ApiManager::traceReply(QNetworkReply *reply, RequestKind kind)
+{
+    static const char *const endpoints[] = {"stations", "sensors", "data"};
+    const QString endpoint = endpoints[static_cast<int>(kind)];
+    Tracer &tracer = Tracer::instance();
+    const qint64 finishedAt = Tracer::now();
+
+    tracer.count("http." + endpoint + ".requests");
+    if (reply->error() != QNetworkReply::NoError)
+        tracer.count("http." + endpoint + ".errors");
+    else if (reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool())
+        tracer.count("http." + endpoint + ".cache_hits");
+
+    // Żądania wysłane przed włączeniem śledzenia nie mają znaczników czasu
+    const QVariant queuedAt = reply->request().attribute(QueuedAtAttribute);
+    const QVariant sentAt = reply->property("traceSentAt");
+    if (!sentAt.isValid())
+        return;
+    const qint64 sent = sentAt.toLongLong();
+    const qint64 firstByte = reply->property("traceFirstByteAt").isValid()
+                                 ? reply->property("traceFirstByteAt").toLongLong() : finishedAt;
+    const quint64 id = quint64(quintptr(reply));
+    const QString path = reply->url().path();
+
+    if (queuedAt.isValid())
+        tracer.asyncSpan("queued", "http", id, queuedAt.toLongLong(), sent, path);
+    tracer.asyncSpan("waiting", "http", id, sent, firstByte, path);
+    tracer.asyncSpan("download", "http", id, firstByte, finishedAt, path);
+    tracer.recordLatency("http." + endpoint, finishedAt - sent);
+    if (queuedAt.isValid())
+        tracer.recordLatency("http." + endpoint + ".queued", sent - queuedAt.toLongLong());
+}
+
+void ApiManager::saveReply(const QString &filename, const QByteArray &data)
+{
+    // Zapis w wątku zapisu, przez plik tymczasowy i zmianę nazwy
+    AsyncWriter::instance().writeFile(filename, data);
+}
+
+void ApiManager::getMeasurementsForSensor(int stationId, int sensorId, RequestPriority priority)
+{
+    enqueue(dataUrl(sensorId), RequestKind::Data, priority, stationId, sensorId);
+}
+void ApiManager::getSensorsForStation(int stationId, RequestPriority priority)
+{
+    enqueue(endpoint(QString("station/sensors/%1").arg(stationId)), RequestKind::Sensors, priority, stationId, 0);
+}
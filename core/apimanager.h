@@ -0,0 +1,105 @@
+#ifndef APIMANAGER_H
+#define APIMANAGER_H
+
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QQueue>
+#include <QSet>
+#include "giosdata.h"
+
+class ApiCache;
+
+// Klasy priorytetu żądań: najpierw stacja wybrana przez użytkownika, potem odświeżanie w tle, na końcu masowe pobieranie
+enum class RequestPriority {
+    Interactive = 0,
+    Refresh = 1,
+    Bulk = 2
+};
+
+// Rodzaj żądania - decyduje, który dekoder obsłuży odpowiedź
+enum class RequestKind {
+    Stations = 0,
+    Sensors = 1,
+    Data = 2
+};
+
+class ApiManager : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ApiManager(QObject *parent = nullptr);
+    static ApiManager &instance();  // Wspólna instancja dla GUI
+
+    void getAirStations(RequestPriority priority = RequestPriority::Interactive);  // Funkcja do pobrania stacji pomiarowych
+    // Skrót zawartości ostatnio odebranego katalogu stacji (jak w nagłówku migawki), 0 przed pierwszym pobraniem
+    quint64 stationsHash() const { return m_stationsHash; }
+    // Skrót migawki, która już leży na dysku (np. wczytanej przy starcie); taki sam katalog nie jest zapisywany ponownie
+    void setSavedStationsHash(quint64 hash) { m_savedStationsHash = hash; }
+    void getMeasurementsForSensor(int stationId, int sensorId, RequestPriority priority = RequestPriority::Interactive);
+    void getSensorsForStation(int stationId, RequestPriority priority = RequestPriority::Interactive);
+
+    // Adres bazowy REST API; domyślnie zmienna środowiskowa GIOS_API_URL lub serwer GIOŚ
+    void setBaseUrl(const QUrl &url);
+    QUrl baseUrl() const { return m_baseUrl; }
+    static QUrl defaultBaseUrl();
+
+    void setMaxInFlight(int count);  // Maksymalna liczba jednocześnie wysłanych żądań
+    int maxInFlight() const { return m_maxInFlight; }
+    // Wstrzymuje wysyłanie kolejnych żądań z kolejek; trwające żądania kończą się normalnie.
+    // Niezależnie od tego wysyłanie stoi, dopóki kolejka wątku zapisu jest przepełniona
+    void setPaused(bool paused);
+    bool isPaused() const { return m_paused; }
+    int pendingCount() const;        // Żądania czekające w kolejkach
+    int inFlightCount() const { return m_inFlight.size(); }
+    void cancelStation(int stationId);  // Anuluje wszystkie oczekujące i trwające żądania dla stacji
+
+    // Statystyki pamięci podręcznej HTTP
+    struct CacheStats {
+        int hits = 0;           // Odpowiedzi obsłużone z cache (także po rewalidacji 304)
+        int misses = 0;         // Odpowiedzi pobrane w całości z sieci
+        int revalidations = 0;  // Wpisy odświeżone odpowiedzią 304
+        qint64 sizeBytes = 0;   // Rozmiar cache na dysku
+    };
+    CacheStats cacheStats() const;
+
+signals:
+    void stationsReceived(const QList<Station> &stations);
+    void sensorsReceived(int stationId, const QList<Sensor> &sensors);
+    void measurementsReceived(const MeasurementSeries &series);
+    void requestFailed(RequestKind kind, int stationId, int sensorId, const QString &error);
+
+private slots:
+    void onReplyFinished(QNetworkReply *reply);
+
+private:
+    // Kontekst żądania zapisany w atrybutach QNetworkRequest
+    static constexpr QNetworkRequest::Attribute KindAttribute = QNetworkRequest::Attribute(QNetworkRequest::User + 1);
+    static constexpr QNetworkRequest::Attribute PriorityAttribute = QNetworkRequest::Attribute(QNetworkRequest::User + 2);
+    static constexpr QNetworkRequest::Attribute StationIdAttribute = QNetworkRequest::Attribute(QNetworkRequest::User + 3);  // 0, gdy żądanie nie dotyczy stacji
+    static constexpr QNetworkRequest::Attribute SensorIdAttribute = QNetworkRequest::Attribute(QNetworkRequest::User + 4);
+    static constexpr QNetworkRequest::Attribute QueuedAtAttribute = QNetworkRequest::Attribute(QNetworkRequest::User + 5);  // Tracer::now() przy włączonym śledzeniu
+
+    void enqueue(const QUrl &url, RequestKind kind, RequestPriority priority, int stationId, int sensorId);
+    QUrl endpoint(const QString &path) const;
+    QUrl dataUrl(int sensorId) const;
+    void dispatch();
+    void saveReply(const QString &filename, const QByteArray &data);
+    void traceReply(QNetworkReply *reply, RequestKind kind);
+
+    QNetworkAccessManager *manager;
+    ApiCache *cache;
+    int m_cacheHits = 0;
+    int m_cacheMisses = 0;
+    int m_cacheRevalidations = 0;
+    quint64 m_stationsHash = 0;
+    quint64 m_savedStationsHash = 0;   // Skrót migawki na dysku (lub zakolejkowanej do zapisu); 0, gdy nieznany lub po nieudanym zapisie
+    QQueue<QNetworkRequest> m_queues[3];            // Jedna kolejka na klasę priorytetu
+    QSet<QNetworkReply *> m_inFlight;
+    int m_maxInFlight = 6;
+    bool m_paused = false;
+    bool m_writerCongested = false;    // AsyncWriter przekroczył próg HighWaterBytes
+    QUrl m_baseUrl;
+};
+
+#endif // APIMANAGER_H
@@ -0,0 +1,313 @@
+#include "asyncwriter.h"
+#include "tracer.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QMap>
+#include <QSaveFile>
+#include <QThread>
+
+namespace {
+
+struct IngestGroup
+{
+    QString directory;
+    SeriesKey key;
+    QList<SeriesColumns> parts;
+};
+
+/**
+ * @brief Scala kolejne porcje pomiarów jednej serii według czasu.
+ * @details Późniejsza porcja nadpisuje wartość z wcześniejszej, ale brakujący odczyt nie nadpisuje
+ * ważnego - tak samo jak przy scalaniu w SeriesStore.
+ */
+SeriesColumns mergeParts(const QList<SeriesColumns> &parts)
+{
+    if (parts.size() == 1)
+        return parts.first();
+
+    QMap<qint64, QPair<float, bool>> merged;
+    for (const SeriesColumns &part : parts) {
+        for (qsizetype i = 0; i < part.size(); ++i) {
+            auto it = merged.find(part.timestamp(i));
+            if (it == merged.end())
+                merged.insert(part.timestamp(i), qMakePair(part.value(i), part.isValid(i)));
+            else if (part.isValid(i) || !it->second)
+                *it = qMakePair(part.value(i), part.isValid(i));
+        }
+    }
+
+    SeriesColumns result;
+    result.reserve(merged.size());
+    for (auto it = merged.cbegin(); it != merged.cend(); ++it)
+        result.append(it.key(), it->first, it->second);
+    return result;
+}
+
+} // namespace
+
+AsyncWriter::AsyncWriter(QObject *parent)
+    : QObject(parent)
+{
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("AsyncWriter");
+    m_thread->start();
+}
+
+AsyncWriter::~AsyncWriter()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_notEmpty.wakeAll();
+        m_notFull.wakeAll();
+    }
+    // Wątek kończy dopiero po opróżnieniu kolejki, więc zamknięcie programu nie gubi zapisów
+    m_thread->wait();
+    delete m_thread;
+}
+
+AsyncWriter &AsyncWriter::instance()
+{
+    static AsyncWriter writer;
+    return writer;
+}
+
+void AsyncWriter::writeFile(const QString &path, const QByteArray &data)
+{
+    Job job;
+    job.kind = Job::File;
+    job.path = path;
+    job.data = data;
+    job.bytes = data.size();
+    enqueue(std::move(job));
+}
+
+void AsyncWriter::ingest(const MeasurementArchive &archive, const SeriesKey &key, const SeriesColumns &columns)
+{
+    if (columns.isEmpty())
+        return;
+
+    Job job;
+    job.kind = Job::Ingest;
+    job.path = archive.directory();
+    job.key = key;
+    job.columns = columns;
+    job.bytes = columns.size() * qint64(sizeof(ArchiveRecord));
+    enqueue(std::move(job));
+}
+
+void AsyncWriter::enqueue(Job &&job)
+{
+    bool changed = false;
+    QString rejectedPath;
+    {
+        QMutexLocker locker(&m_mutex);
+        const bool overLimit = m_stats.queuedBytes > 0 && m_stats.queuedBytes + job.bytes > HardLimitBytes && !m_stopping;
+        if (overLimit && QThread::currentThread() == m_nonBlockingThread) {
+            // Wątek GUI nie czeka na dysk: nowsze dane zastępują czekające albo są odrzucane
+            if (coalesceQueued(job)) {
+                ++m_stats.jobs;
+                ++m_stats.coalesced;
+                return;
+            }
+            ++m_stats.rejected;
+            if (Tracer::isEnabled())
+                Tracer::instance().count("writer.rejected");
+            rejectedPath = job.kind == Job::File ? job.path : MeasurementArchive(job.path).pathFor(job.key);
+        } else if (overLimit) {
+            // Twardy limit: producent czeka, aż wątek zapisu zwolni miejsce
+            TraceSpan span("writer stall", "io");
+            ++m_stats.stalls;
+            if (Tracer::isEnabled())
+                Tracer::instance().count("writer.stalls");
+            while (m_stats.queuedBytes > 0 && m_stats.queuedBytes + job.bytes > HardLimitBytes && !m_stopping)
+                m_notFull.wait(&m_mutex);
+        }
+        if (rejectedPath.isEmpty()) {
+            m_stats.queuedBytes += job.bytes;
+            ++m_stats.jobs;
+            m_queue.append(std::move(job));
+            changed = updateCongestion();
+            m_notEmpty.wakeOne();
+        }
+    }
+    if (!rejectedPath.isEmpty())
+        emit writeFailed(rejectedPath, "Kolejka zapisu jest pełna");
+    if (changed)
+        emit congestionChanged(true);
+}
+
+bool AsyncWriter::coalesceQueued(const Job &job)
+{
+    // Najnowsze czekające zadanie dla tego samego pliku lub serii przejmuje nowe dane
+    for (qsizetype i = m_queue.size() - 1; i >= 0; --i) {
+        Job &queued = m_queue[i];
+        if (queued.kind != job.kind || queued.path != job.path || (job.kind == Job::Ingest && !(queued.key == job.key)))
+            continue;
+        m_stats.queuedBytes -= queued.bytes;
+        if (job.kind == Job::File) {
+            queued.data = job.data;
+            queued.bytes = queued.data.size();
+        } else {
+            queued.columns = mergeParts({queued.columns, job.columns});
+            queued.bytes = queued.columns.size() * qint64(sizeof(ArchiveRecord));
+        }
+        m_stats.queuedBytes += queued.bytes;
+        return true;
+    }
+    return false;
+}
+
+void AsyncWriter::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_queue.isEmpty() || m_writing)
+        m_drained.wait(&m_mutex);
+}
+
+void AsyncWriter::setNonBlockingThread(QThread *thread)
+{
+    QMutexLocker locker(&m_mutex);
+    m_nonBlockingThread = thread;
+}
+
+bool AsyncWriter::isCongested() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_congested;
+}
+
+AsyncWriter::Stats AsyncWriter::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+bool AsyncWriter::updateCongestion()
+{
+    // Histereza: sygnał włącza się na progu i gaśnie dopiero przy połowie progu
+    const bool congested = m_congested ? m_stats.queuedBytes > HighWaterBytes / 2
+                                       : m_stats.queuedBytes > HighWaterBytes;
+    if (congested == m_congested)
+        return false;
+    m_congested = congested;
+    return true;
+}
+
+void AsyncWriter::run()
+{
+    forever {
+        QList<Job> batch;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_queue.isEmpty() && !m_stopping)
+                m_notEmpty.wait(&m_mutex);
+            if (m_queue.isEmpty())
+                return;
+            batch.swap(m_queue);
+            m_writing = true;
+        }
+
+        writeBatch(batch);
+
+        qint64 bytes = 0;
+        for (const Job &job : batch)
+            bytes += job.bytes;
+
+        bool changed = false;
+        bool congested = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            m_stats.queuedBytes -= bytes;
+            ++m_stats.batches;
+            m_writing = false;
+            changed = updateCongestion();
+            congested = m_congested;
+            m_notFull.wakeAll();
+            if (m_queue.isEmpty())
+                m_drained.wakeAll();
+        }
+        if (changed)
+            emit congestionChanged(congested);
+    }
+}
+
+void AsyncWriter::writeBatch(const QList<Job> &batch)
+{
+    TraceSpan span("writer batch", "io");
+
+    // Scalanie partii: najnowsza treść każdego pliku i jedna porcja pomiarów na serię
+    QHash<QString, qsizetype> latestFile;
+    QList<IngestGroup> groups;
+    QHash<QPair<QString, SeriesKey>, qsizetype> groupIndex;
+    qint64 coalesced = 0;
+    for (qsizetype i = 0; i < batch.size(); ++i) {
+        const Job &job = batch[i];
+        if (job.kind == Job::File) {
+            if (latestFile.contains(job.path))
+                ++coalesced;
+            latestFile[job.path] = i;
+            continue;
+        }
+        const auto id = qMakePair(job.path, job.key);
+        auto it = groupIndex.find(id);
+        if (it == groupIndex.end()) {
+            groupIndex.insert(id, groups.size());
+            groups.append(IngestGroup{job.path, job.key, {job.columns}});
+        } else {
+            groups[*it].parts.append(job.columns);
+            ++coalesced;
+        }
+    }
+
+    qint64 bytesWritten = 0;
+    qint64 failures = 0;
+    for (const IngestGroup &group : groups) {
+        TraceSpan ingestSpan("writer ingest", "io");
+        MeasurementArchive archive(group.directory);
+        const MeasurementArchive::IngestStats result = archive.ingest(group.key, mergeParts(group.parts));
+        if (!result.ok()) {
+            ++failures;
+            emit writeFailed(archive.pathFor(group.key), result.error);
+        }
+    }
+
+    for (auto it = latestFile.cbegin(); it != latestFile.cend(); ++it) {
+        const Job &job = batch[it.value()];
+        const QString dir = QFileInfo(job.path).path();
+        if (!dir.isEmpty())
+            QDir().mkpath(dir);
+
+        // QSaveFile pisze do pliku tymczasowego i podmienia docelowy dopiero w commit()
+        QSaveFile file(job.path);
+        QString error;
+        if (!file.open(QIODevice::WriteOnly))
+            error = file.errorString();
+        else if (file.write(job.data) != job.data.size())
+            error = file.errorString();
+        if (error.isEmpty() && !file.commit())
+            error = file.errorString();
+
+        if (error.isEmpty()) {
+            bytesWritten += job.data.size();
+            qDebug() << "Dane zapisane do:" << job.path;
+        } else {
+            file.cancelWriting();
+            ++failures;
+            qDebug() << "Nie udało się zapisać pliku:" << job.path << error;
+            emit writeFailed(job.path, error);
+        }
+    }
+
+    if (Tracer::isEnabled()) {
+        Tracer::instance().count("writer.batches");
+        Tracer::instance().count("writer.coalesced", coalesced);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_stats.coalesced += coalesced;
+    m_stats.bytesWritten += bytesWritten;
+    m_stats.failures += failures;
+}
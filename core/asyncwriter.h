@@ -0,0 +1,105 @@
+#ifndef ASYNCWRITER_H
+#define ASYNCWRITER_H
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QWaitCondition>
+#include "measurementarchive.h"
+
+class QThread;
+
+/**
+ * @brief Zapis na dysk w osobnym wątku, z ograniczoną kolejką i grupowaniem zapisów.
+ * @details Wątek GUI i pętla zdarzeń sieci tylko kolejkują zadania. Wątek zapisu zabiera całą
+ * kolejkę naraz i scala ją: z kilku zapisów tego samego pliku zostaje najnowszy, a kolejne porcje
+ * pomiarów tej samej serii trafiają do archiwum jednym ingestem. Pliki są zapisywane przez plik
+ * tymczasowy i zmianę nazwy (QSaveFile), więc przerwany zapis nie zostawia połowy pliku.
+ *
+ * Po przekroczeniu progu HighWaterBytes wysyłany jest sygnał congestionChanged(true), na który
+ * ApiManager wstrzymuje wysyłanie żądań; po spadku do połowy progu - false.
+ * Po przekroczeniu HardLimitBytes kolejkowanie blokuje wywołującego do czasu zwolnienia miejsca.
+ * Wyjątkiem jest wątek wskazany przez setNonBlockingThread (wątek GUI): jego zadanie jest scalane
+ * z czekającym zadaniem dla tego samego pliku lub serii, a gdy takiego nie ma - odrzucane
+ * z sygnałem writeFailed, bez czekania. Przy wstrzymanych żądaniach to tylko ostateczność.
+ */
+class AsyncWriter : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr qint64 HighWaterBytes = 8 * 1024 * 1024;
+    static constexpr qint64 HardLimitBytes = 64 * 1024 * 1024;
+
+    struct Stats {
+        qint64 jobs = 0;            ///< Przyjęte zadania.
+        qint64 batches = 0;         ///< Partie obsłużone przez wątek zapisu.
+        qint64 coalesced = 0;       ///< Zadania scalone z innymi w tej samej partii.
+        qint64 bytesWritten = 0;    ///< Bajty zapisane do plików (bez archiwum).
+        qint64 queuedBytes = 0;     ///< Bieżący rozmiar kolejki.
+        qint64 stalls = 0;          ///< Wywołania zablokowane na limicie kolejki.
+        qint64 rejected = 0;        ///< Zadania wątku nieblokującego odrzucone na limicie kolejki.
+        qint64 failures = 0;        ///< Nieudane zapisy.
+    };
+
+    explicit AsyncWriter(QObject *parent = nullptr);
+    ~AsyncWriter() override;
+
+    static AsyncWriter &instance();  // Wspólny wątek zapisu dla całego procesu
+
+    /**
+     * @brief Kolejkuje zapis całego pliku; nowszy zapis tej samej ścieżki zastępuje starszy.
+     */
+    void writeFile(const QString &path, const QByteArray &data);
+    /**
+     * @brief Kolejkuje ingest serii do archiwum w katalogu archive.directory().
+     */
+    void ingest(const MeasurementArchive &archive, const SeriesKey &key, const SeriesColumns &columns);
+    /**
+     * @brief Czeka, aż wszystkie zakolejkowane zadania trafią na dysk.
+     * @details Blokuje wywołującego - nie wywoływać z wątku GUI.
+     */
+    void flush();
+    /**
+     * @brief Wskazuje wątek, który nigdy nie czeka na limit kolejki (zwykle wątek GUI).
+     */
+    void setNonBlockingThread(QThread *thread);
+
+    bool isCongested() const;
+    Stats stats() const;
+
+signals:
+    void congestionChanged(bool congested);
+    void writeFailed(const QString &path, const QString &error);
+
+private:
+    struct Job
+    {
+        enum Kind { File, Ingest } kind = File;
+        QString path;           ///< Ścieżka pliku albo katalog archiwum.
+        SeriesKey key;
+        QByteArray data;
+        SeriesColumns columns;
+        qint64 bytes = 0;
+    };
+
+    void enqueue(Job &&job);
+    bool coalesceQueued(const Job &job);   // Wywoływane pod m_mutex; true, gdy zadanie scalono z czekającym
+    void run();
+    void writeBatch(const QList<Job> &batch);
+    bool updateCongestion();   // Wywoływane pod m_mutex; true, gdy stan się zmienił
+
+    QThread *m_thread = nullptr;
+    QThread *m_nonBlockingThread = nullptr;
+    mutable QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    QWaitCondition m_notFull;
+    QWaitCondition m_drained;
+    QList<Job> m_queue;
+    Stats m_stats;
+    bool m_writing = false;
+    bool m_congested = false;
+    bool m_stopping = false;
+};
+
+#endif // ASYNCWRITER_H
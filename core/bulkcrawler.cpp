@@ -0,0 +1,110 @@
+#include "bulkcrawler.h"
+#include "asyncwriter.h"
+#include <QDebug>
+
+BulkCrawler::BulkCrawler(ApiManager *apiManager, MeasurementArchive *archive, QObject *parent)
+    : QObject(parent),
+    m_api(apiManager),
+    m_archive(archive)
+{
+    m_progressTimer.setInterval(1000);
+    connect(&m_progressTimer, &QTimer::timeout, this, [this]() {
+        emit progress(stats());
+    });
+}
+
+void BulkCrawler::start()
+{
+    if (m_running)
+        return;
+
+    m_stats = Stats();
+    m_stationsDone = false;
+    m_running = true;
+
+    connect(m_api, &ApiManager::stationsReceived, this, &BulkCrawler::onStationsReceived);
+    connect(m_api, &ApiManager::sensorsReceived, this, &BulkCrawler::onSensorsReceived);
+    connect(m_api, &ApiManager::measurementsReceived, this, &BulkCrawler::onMeasurementsReceived);
+    connect(m_api, &ApiManager::requestFailed, this, &BulkCrawler::onRequestFailed);
+
+    m_api->setMaxInFlight(m_concurrency);
+    m_elapsed.start();
+    m_progressTimer.start();
+    m_api->getAirStations(RequestPriority::Bulk);
+}
+
+BulkCrawler::Stats BulkCrawler::stats() const
+{
+    Stats current = m_stats;
+    current.elapsedMs = m_elapsed.isValid() ? m_elapsed.elapsed() : 0;
+    return current;
+}
+
+void BulkCrawler::onStationsReceived(const QList<Station> &stations)
+{
+    ++m_stats.requests;
+    m_stats.stations = stations.size();
+    m_stationsDone = true;
+    for (const Station &station : stations)
+        m_api->getSensorsForStation(station.id, RequestPriority::Bulk);
+    checkFinished();
+}
+
+void BulkCrawler::onSensorsReceived(int, const QList<Sensor> &sensors)
+{
+    // Dane czujników ApiManager kolejkuje sam, z priorytetem listy czujników
+    ++m_stats.requests;
+    ++m_stats.sensorListsDone;
+    m_stats.sensorsTotal += sensors.size();
+    checkFinished();
+}
+
+void BulkCrawler::onMeasurementsReceived(const MeasurementSeries &series)
+{
+    ++m_stats.requests;
+    ++m_stats.sensorsDone;
+
+    const SeriesColumns columns = SeriesStore::columnsFromPoints(series.values);
+    AsyncWriter::instance().ingest(*m_archive, SeriesKey{series.stationId, series.paramCode}, columns);
+    for (qsizetype i = 0; i < columns.size(); ++i) {
+        if (columns.isValid(i))
+            ++m_stats.points;
+    }
+    checkFinished();
+}
+
+void BulkCrawler::onRequestFailed(RequestKind kind, int stationId, int sensorId, const QString &error)
+{
+    ++m_stats.requests;
+    ++m_stats.failures;
+    switch (kind) {
+    case RequestKind::Stations:
+        m_stationsDone = true;
+        break;
+    case RequestKind::Sensors:
+        ++m_stats.sensorListsDone;
+        break;
+    case RequestKind::Data:
+        ++m_stats.sensorsDone;
+        break;
+    }
+    emit failed(kind, stationId, sensorId, error);
+    checkFinished();
+}
+
+void BulkCrawler::checkFinished()
+{
+    if (!m_stationsDone || m_stats.sensorListsDone < m_stats.stations
+        || m_stats.sensorsDone < m_stats.sensorsTotal)
+        return;
+
+    m_running = false;
+    m_progressTimer.stop();
+    disconnect(m_api, nullptr, this, nullptr);
+
+    // Wynik zgłaszamy dopiero, gdy wszystkie serie są już w archiwum
+    AsyncWriter::instance().flush();
+    const Stats result = stats();
+    emit progress(result);
+    emit finished(result);
+}
@@ -0,0 +1,69 @@
+#ifndef BULKCRAWLER_H
+#define BULKCRAWLER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include "apimanager.h"
+#include "measurementarchive.h"
+
+/**
+ * @brief Bezgłowe pobieranie danych ze wszystkich stacji i czujników.
+ * @details Pobiera listę stacji, następnie listy czujników i dane każdego czujnika
+ * z priorytetem Bulk, w ramach globalnego limitu jednoczesnych żądań ApiManager.
+ * Wyniki trafiają do archiwum pomiarów przez wątek zapisu (AsyncWriter); przy przepełnionej
+ * kolejce zapisu ApiManager wstrzymuje wysyłanie żądań.
+ */
+class BulkCrawler : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Stan postępu i przepustowość pobierania.
+     */
+    struct Stats {
+        int stations = 0;               ///< Liczba stacji w katalogu.
+        int sensorListsDone = 0;        ///< Odebrane (lub nieudane) listy czujników.
+        int sensorsTotal = 0;           ///< Liczba czujników do pobrania.
+        int sensorsDone = 0;            ///< Odebrane serie pomiarowe.
+        int failures = 0;               ///< Nieudane żądania.
+        qint64 requests = 0;            ///< Zakończone żądania (z błędami włącznie).
+        qint64 points = 0;              ///< Ważne pomiary w odebranych odpowiedziach (przed zapisem i odrzuceniem duplikatów).
+        qint64 elapsedMs = 0;           ///< Czas od startu.
+
+        double requestsPerSecond() const { return elapsedMs > 0 ? requests * 1000.0 / elapsedMs : 0.0; }
+        double pointsPerSecond() const { return elapsedMs > 0 ? points * 1000.0 / elapsedMs : 0.0; }
+    };
+
+    explicit BulkCrawler(ApiManager *apiManager, MeasurementArchive *archive, QObject *parent = nullptr);
+
+    void setConcurrency(int maxInFlight) { m_concurrency = maxInFlight; }
+    void start();
+    bool isRunning() const { return m_running; }
+    Stats stats() const;
+
+signals:
+    void progress(const BulkCrawler::Stats &stats);
+    void failed(RequestKind kind, int stationId, int sensorId, const QString &error);
+    void finished(const BulkCrawler::Stats &stats);
+
+private slots:
+    void onStationsReceived(const QList<Station> &stations);
+    void onSensorsReceived(int stationId, const QList<Sensor> &sensors);
+    void onMeasurementsReceived(const MeasurementSeries &series);
+    void onRequestFailed(RequestKind kind, int stationId, int sensorId, const QString &error);
+
+private:
+    void checkFinished();
+
+    ApiManager *m_api;
+    MeasurementArchive *m_archive;
+    QTimer m_progressTimer;
+    QElapsedTimer m_elapsed;
+    Stats m_stats;
+    int m_concurrency = 8;
+    bool m_running = false;
+    bool m_stationsDone = false;
+};
+
+#endif // BULKCRAWLER_H
@@ -0,0 +1,13 @@
+# Opcjonalna kompresja eksportu: włączana, gdy pkg-config znajdzie bibliotekę.
+# Dołączane przez core.pro (definicje) i core.pri (linkowanie w programach korzystających z core).
+unix {
+    CONFIG += link_pkgconfig
+    packagesExist(zlib) {
+        PKGCONFIG += zlib
+        DEFINES += HAVE_ZLIB
+    }
+    packagesExist(libzstd) {
+        PKGCONFIG += libzstd
+        DEFINES += HAVE_ZSTD
+    }
+}
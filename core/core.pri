@@ -0,0 +1,17 @@
+# Dołączane przez projekty korzystające z biblioteki core
+QT += core network concurrent
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+include($$PWD/compression.pri)
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../core/release/ -lpogodacore
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../core/debug/ -lpogodacore
+else:unix: LIBS += -L$$OUT_PWD/../core/ -lpogodacore
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/libpogodacore.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/libpogodacore.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/pogodacore.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/pogodacore.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../core/libpogodacore.a
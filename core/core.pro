@@ -0,0 +1,61 @@
+QT       = core network concurrent
+
+TEMPLATE = lib
+CONFIG += staticlib c++17
+TARGET = pogodacore
+
+include(compression.pri)
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    analysisservice.cpp \
+    apicache.cpp \
+    apimanager.cpp \
+    asyncwriter.cpp \
+    bulkcrawler.cpp \
+    dateparser.cpp \
+    downsample.cpp \
+    giosparser.cpp \
+    measurementarchive.cpp \
+    regionreport.cpp \
+    runningaggregate.cpp \
+    seriesanalysis.cpp \
+    seriesexport.cpp \
+    seriesrollup.cpp \
+    seriesstore.cpp \
+    stationgeoindex.cpp \
+    stationmodel.cpp \
+    stationsearch.cpp \
+    stationsnapshot.cpp \
+    statkernels.cpp \
+    tracer.cpp
+
+HEADERS += \
+    analysisservice.h \
+    apicache.h \
+    apimanager.h \
+    asyncwriter.h \
+    bulkcrawler.h \
+    dateparser.h \
+    downsample.h \
+    giosdata.h \
+    giosparser.h \
+    measurementarchive.h \
+    regionreport.h \
+    runningaggregate.h \
+    seriesanalysis.h \
+    seriesexport.h \
+    seriesrollup.h \
+    seriesstore.h \
+    stationgeoindex.h \
+    stationmodel.h \
+    stationsearch.h \
+    stationsnapshot.h \
+    statkernels.h \
+    tracer.h
+
+DISTFILES += \
+    compression.pri
@@ -0,0 +1,64 @@
+#include "dateparser.h"
+#include <QDateTime>
+
+namespace {
+
+inline int digit(QChar c)
+{
+    const char16_t u = c.unicode();
+    return (u >= u'0' && u <= u'9') ? int(u - u'0') : -1;
+}
+
+// Odczytuje count cyfr od pozycji pos; -1, jeśli któryś znak nie jest cyfrą
+inline int number(QStringView text, qsizetype pos, int count)
+{
+    int value = 0;
+    for (int i = 0; i < count; ++i) {
+        const int d = digit(text[pos + i]);
+        if (d < 0)
+            return -1;
+        value = value * 10 + d;
+    }
+    return value;
+}
+
+} // namespace
+
+bool DateParser::parse(QStringView text, qint64 *msecs)
+{
+    // Strefa czasowa lub ułamki sekund ("Z", "+02:00", ".123") - nie zgadujemy, oddajemy wywołującemu
+    if (text.size() != 19 || text[4] != u'-' || text[7] != u'-'
+        || (text[10] != u' ' && text[10] != u'T') || text[13] != u':' || text[16] != u':')
+        return false;
+
+    const int year = number(text, 0, 4);
+    const int month = number(text, 5, 2);
+    const int day = number(text, 8, 2);
+    const int hour = number(text, 11, 2);
+    const int minute = number(text, 14, 2);
+    const int second = number(text, 17, 2);
+    if (year < 0 || month < 1 || month > 12 || day < 1 || day > 31
+        || hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59)
+        return false;
+
+    const int dayKey = (year * 16 + month) * 32 + day;
+    if (dayKey != m_dayKey) {
+        const QDate date(year, month, day);
+        if (!date.isValid())
+            return false;
+        const QDateTime start = date.startOfDay();
+        const QDateTime next = date.addDays(1).startOfDay();
+        m_dayKey = dayKey;
+        m_dayStart = start.toMSecsSinceEpoch();
+        m_uniformOffset = start.offsetFromUtc() == next.offsetFromUtc() && start.time() == QTime(0, 0);
+    }
+
+    if (!m_uniformOffset) {
+        // Doba ze zmianą czasu: dokładne przeliczenie przez QDateTime
+        *msecs = QDateTime(QDate(year, month, day), QTime(hour, minute, second)).toMSecsSinceEpoch();
+        return true;
+    }
+
+    *msecs = m_dayStart + ((hour * 60 + minute) * 60 + second) * qint64(1000);
+    return true;
+}
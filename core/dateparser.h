@@ -0,0 +1,33 @@
+#ifndef DATEPARSER_H
+#define DATEPARSER_H
+
+#include <QStringView>
+#include <QtGlobal>
+
+/**
+ * @brief Szybki parser dat GIOŚ w stałym formacie "yyyy-MM-dd HH:mm:ss" (czas lokalny).
+ * @details Cyfry są odczytywane bezpośrednio z tekstu, bez QDateTime::fromString.
+ * Przesunięcie strefy czasowej liczone jest raz na dobę i zapamiętywane, więc kolejne
+ * pomiary z tego samego dnia kosztują kilka operacji arytmetycznych. W dniach zmiany
+ * czasu (letni/zimowy) parser przechodzi na dokładne, wolniejsze przeliczenie.
+ * Obiekt nie jest współdzielony między wątkami - każdy wątek tworzy własny.
+ */
+class DateParser
+{
+public:
+    /**
+     * @brief Zamienia tekst daty na milisekundy od epoki.
+     * @param text Data w formacie "yyyy-MM-dd HH:mm:ss" (dopuszczalne też "T" jako separator).
+     * @param msecs Wynik; niezmieniony przy błędzie.
+     * @return false, jeśli tekst nie ma oczekiwanego formatu (także przy dopisanej strefie
+     * czasowej lub ułamkach sekund) albo data jest niepoprawna.
+     */
+    bool parse(QStringView text, qint64 *msecs);
+
+private:
+    int m_dayKey = -1;              ///< Klucz (rok, miesiąc, dzień) zapamiętanej doby.
+    qint64 m_dayStart = 0;          ///< Lokalna północ zapamiętanej doby (ms od epoki).
+    bool m_uniformOffset = false;   ///< Czy przesunięcie strefy jest stałe przez całą dobę.
+};
+
+#endif // DATEPARSER_H
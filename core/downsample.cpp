@@ -0,0 +1,52 @@
+#include "downsample.h"
+#include <cmath>
+
+QList<QPointF> Downsample::lttb(const QList<QPointF> &points, qsizetype threshold)
+{
+    const qsizetype n = points.size();
+    if (threshold >= n || threshold < 3)
+        return points;
+
+    QList<QPointF> sampled;
+    sampled.reserve(threshold);
+    sampled.append(points.first());
+
+    // Pierwszy i ostatni punkt zostają; pozostałe dzielimy na threshold - 2 przedziałów
+    const double every = double(n - 2) / (threshold - 2);
+    qsizetype selected = 0;
+
+    for (qsizetype bucket = 0; bucket < threshold - 2; ++bucket) {
+        // Średnia następnego przedziału jest trzecim wierzchołkiem trójkąta
+        const qsizetype nextBegin = qsizetype((bucket + 1) * every) + 1;
+        const qsizetype nextEnd = qMin(qsizetype((bucket + 2) * every) + 1, n);
+        double avgX = 0.0;
+        double avgY = 0.0;
+        for (qsizetype i = nextBegin; i < nextEnd; ++i) {
+            avgX += points[i].x();
+            avgY += points[i].y();
+        }
+        const qsizetype nextCount = qMax<qsizetype>(1, nextEnd - nextBegin);
+        avgX /= nextCount;
+        avgY /= nextCount;
+
+        const qsizetype begin = qsizetype(bucket * every) + 1;
+        const qsizetype end = qsizetype((bucket + 1) * every) + 1;
+        const QPointF &a = points[selected];
+        double maxArea = -1.0;
+        qsizetype best = begin;
+        for (qsizetype i = begin; i < end; ++i) {
+            const double area = std::abs((a.x() - avgX) * (points[i].y() - a.y())
+                                         - (a.x() - points[i].x()) * (avgY - a.y()));
+            if (area > maxArea) {
+                maxArea = area;
+                best = i;
+            }
+        }
+
+        sampled.append(points[best]);
+        selected = best;
+    }
+
+    sampled.append(points.last());
+    return sampled;
+}
@@ -0,0 +1,22 @@
+#ifndef DOWNSAMPLE_H
+#define DOWNSAMPLE_H
+
+#include <QList>
+#include <QPointF>
+
+/**
+ * @brief Decymacja serii przed rysowaniem, zachowująca kształt wykresu.
+ */
+namespace Downsample
+{
+/**
+ * @brief Largest-Triangle-Three-Buckets: wybiera z każdego przedziału punkt tworzący
+ * największy trójkąt z sąsiednimi wyborami, dzięki czemu zachowuje szczyty i doliny.
+ * @param points Punkty posortowane rosnąco po x.
+ * @param threshold Docelowa liczba punktów (zwykle szerokość wykresu w pikselach).
+ * @return Co najwyżej threshold punktów; wejście bez zmian, jeśli jest krótsze.
+ */
+QList<QPointF> lttb(const QList<QPointF> &points, qsizetype threshold);
+}
+
+#endif // DOWNSAMPLE_H
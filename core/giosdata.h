@@ -0,0 +1,62 @@
+#ifndef GIOSDATA_H
+#define GIOSDATA_H
+
+#include <QString>
+#include <QList>
+#include <QMetaType>
+#include <QtNumeric>
+
+/**
+ * @brief Stacja pomiarowa zwracana przez endpoint station/findAll.
+ */
+struct Station
+{
+    int id = 0;                 ///< ID stacji w GIOŚ.
+    QString name;               ///< Nazwa stacji (stationName).
+    QString cityName;           ///< Nazwa miasta.
+    QString communeName;        ///< Nazwa gminy.
+    QString districtName;       ///< Nazwa powiatu.
+    QString provinceName;       ///< Nazwa województwa.
+    double latitude = qQNaN();  ///< Szerokość geograficzna (gegrLat), NaN gdy brak.
+    double longitude = qQNaN(); ///< Długość geograficzna (gegrLon), NaN gdy brak.
+
+    bool hasLocation() const { return !qIsNaN(latitude) && !qIsNaN(longitude); }
+};
+
+/**
+ * @brief Czujnik (stanowisko pomiarowe) zwracany przez endpoint station/sensors.
+ */
+struct Sensor
+{
+    int id = 0;                 ///< ID czujnika.
+    int stationId = 0;          ///< ID stacji, do której należy czujnik.
+    QString paramCode;          ///< Kod parametru, np. "PM10".
+    QString paramName;          ///< Pełna nazwa parametru.
+};
+
+/**
+ * @brief Pojedynczy pomiar z endpointu data/getData.
+ */
+struct MeasurementPoint
+{
+    QString date;               ///< Data w formacie "yyyy-MM-dd HH:mm:ss".
+    double value = 0.0;         ///< Zmierzona wartość.
+    bool valid = false;         ///< false, gdy API zwróciło null.
+};
+
+/**
+ * @brief Seria pomiarowa jednego parametru.
+ */
+struct MeasurementSeries
+{
+    int stationId = 0;                  ///< ID stacji (z kontekstu żądania).
+    int sensorId = 0;                   ///< ID czujnika (z kontekstu żądania).
+    QString paramCode;                  ///< Kod parametru (pole "key").
+    QList<MeasurementPoint> values;     ///< Pomiary w kolejności z API.
+};
+
+Q_DECLARE_METATYPE(Station)
+Q_DECLARE_METATYPE(Sensor)
+Q_DECLARE_METATYPE(MeasurementSeries)
+
+#endif // GIOSDATA_H
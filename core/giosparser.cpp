@@ -0,0 +1,147 @@
+#include "giosparser.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QJsonParseError>
+#include <QVariant>
+#include "tracer.h"
+
+namespace {
+
+bool parseDocument(const QByteArray &json, QJsonDocument &doc, QString *error)
+{
+    QJsonParseError parseError;
+    doc = QJsonDocument::fromJson(json, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        if (error)
+            *error = parseError.errorString();
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool GiosParser::parseStations(const QByteArray &json, QList<Station> &stations, QString *error)
+{
+    TraceSpan span("parse stations", "parse");
+    QJsonDocument doc;
+    if (!parseDocument(json, doc, error))
+        return false;
+
+    if (!doc.isArray()) {
+        if (error)
+            *error = "Dokument nie zawiera listy stacji";
+        return false;
+    }
+
+    stations = stationsFromJson(doc.array());
+    return true;
+}
+
+bool GiosParser::parseSensors(const QByteArray &json, QList<Sensor> &sensors, QString *error)
+{
+    TraceSpan span("parse sensors", "parse");
+    QJsonDocument doc;
+    if (!parseDocument(json, doc, error))
+        return false;
+
+    if (!doc.isArray()) {
+        if (error)
+            *error = "Dokument nie zawiera listy czujników";
+        return false;
+    }
+
+    sensors = sensorsFromJson(doc.array());
+    return true;
+}
+
+bool GiosParser::parseMeasurements(const QByteArray &json, MeasurementSeries &series, QString *error)
+{
+    TraceSpan span("parse measurements", "parse");
+    QJsonDocument doc;
+    if (!parseDocument(json, doc, error))
+        return false;
+
+    if (!doc.isObject() || !doc.object().contains("values")) {
+        if (error)
+            *error = "Dokument nie zawiera danych pomiarowych";
+        return false;
+    }
+
+    series = measurementsFromJson(doc.object());
+    return true;
+}
+
+QList<Station> GiosParser::stationsFromJson(const QJsonArray &array)
+{
+    QList<Station> stations;
+    stations.reserve(array.size());
+    for (const QJsonValue &val : array) {
+        const QJsonObject obj = val.toObject();
+        const QJsonObject city = obj["city"].toObject();
+        const QJsonObject commune = city["commune"].toObject();
+
+        Station station;
+        station.id = obj["id"].toInt();
+        station.name = obj["stationName"].toString();
+        station.cityName = city["name"].toString();
+        station.communeName = commune["communeName"].toString();
+        station.districtName = commune["districtName"].toString();
+        station.provinceName = commune["provinceName"].toString();
+        // API zwraca współrzędne jako tekst ("50.057678"); akceptujemy też liczby
+        bool latOk = false;
+        bool lonOk = false;
+        const double lat = obj["gegrLat"].toVariant().toDouble(&latOk);
+        const double lon = obj["gegrLon"].toVariant().toDouble(&lonOk);
+        if (latOk && lonOk) {
+            station.latitude = lat;
+            station.longitude = lon;
+        }
+        stations.append(station);
+    }
+    return stations;
+}
+
+QList<Sensor> GiosParser::sensorsFromJson(const QJsonArray &array)
+{
+    QList<Sensor> sensors;
+    sensors.reserve(array.size());
+    for (const QJsonValue &val : array) {
+        const QJsonObject obj = val.toObject();
+        const QJsonObject param = obj["param"].toObject();
+
+        Sensor sensor;
+        sensor.id = obj["id"].toInt();
+        sensor.stationId = obj["stationId"].toInt();
+        sensor.paramCode = param["paramCode"].toString();
+        sensor.paramName = param["paramName"].toString();
+        sensors.append(sensor);
+    }
+    return sensors;
+}
+
+MeasurementSeries GiosParser::measurementsFromJson(const QJsonObject &obj)
+{
+    MeasurementSeries series;
+    series.paramCode = obj["key"].toString();
+    series.values = measurementPointsFromJson(obj["values"].toArray());
+    return series;
+}
+
+QList<MeasurementPoint> GiosParser::measurementPointsFromJson(const QJsonArray &values)
+{
+    QList<MeasurementPoint> points;
+    points.reserve(values.size());
+    for (const QJsonValue &val : values) {
+        const QJsonObject v = val.toObject();
+        const QJsonValue value = v["value"];
+
+        MeasurementPoint point;
+        point.date = v["date"].toString();
+        point.valid = !value.isNull() && !value.isUndefined();
+        point.value = point.valid ? value.toDouble() : 0.0;
+        points.append(point);
+    }
+    return points;
+}
@@ -0,0 +1,27 @@
+#ifndef GIOSPARSER_H
+#define GIOSPARSER_H
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include "giosdata.h"
+
+/**
+ * @brief Dekodery odpowiedzi API GIOŚ.
+ * @details Każda funkcja parsuje odpowiedź dokładnie raz, bezpośrednio z QByteArray,
+ * i zwraca gotowe struktury. W razie błędu zwraca false i opcjonalnie opis błędu.
+ */
+namespace GiosParser
+{
+bool parseStations(const QByteArray &json, QList<Station> &stations, QString *error = nullptr);
+bool parseSensors(const QByteArray &json, QList<Sensor> &sensors, QString *error = nullptr);
+bool parseMeasurements(const QByteArray &json, MeasurementSeries &series, QString *error = nullptr);
+
+QList<Station> stationsFromJson(const QJsonArray &array);
+QList<Sensor> sensorsFromJson(const QJsonArray &array);
+MeasurementSeries measurementsFromJson(const QJsonObject &obj);
+
+QList<MeasurementPoint> measurementPointsFromJson(const QJsonArray &values);
+}
+
+#endif // GIOSPARSER_H
@@ -0,0 +1,358 @@
+#include "measurementarchive.h"
+#include "tracer.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QMap>
+#include <QSaveFile>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr char Magic[4] = {'G', 'I', 'O', 'A'};
+constexpr quint16 FormatVersion = 1;
+constexpr quint32 ValidFlag = 0x1;
+
+ArchiveHeader makeHeader(quint64 sortedCount)
+{
+    ArchiveHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = FormatVersion;
+    header.recordSize = sizeof(ArchiveRecord);
+    header.sortedCount = sortedCount;
+    return header;
+}
+
+bool sameReading(const ArchiveRecord &record, float value, bool valid)
+{
+    const bool recordValid = record.flags & ValidFlag;
+    if (recordValid != valid)
+        return false;
+    return !valid || record.value == value;
+}
+
+} // namespace
+
+ArchiveSegment::ArchiveSegment(const QString &path)
+    : m_file(path)
+{
+}
+
+ArchiveSegment::~ArchiveSegment()
+{
+    close();
+}
+
+bool ArchiveSegment::open()
+{
+    close();
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 fileSize = m_file.size();
+    if (fileSize < qint64(sizeof(ArchiveHeader))) {
+        m_file.close();
+        return false;
+    }
+
+    m_map = m_file.map(0, fileSize);
+    if (!m_map) {
+        m_file.close();
+        return false;
+    }
+
+    ArchiveHeader header;
+    std::memcpy(&header, m_map, sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0
+        || header.version != FormatVersion
+        || header.recordSize != sizeof(ArchiveRecord)) {
+        qDebug() << "Nieprawidłowy nagłówek segmentu archiwum:" << m_file.fileName();
+        close();
+        return false;
+    }
+
+    // Niepełny rekord na końcu (przerwany zapis) jest ignorowany
+    m_records = reinterpret_cast<const ArchiveRecord *>(m_map + sizeof(ArchiveHeader));
+    m_count = (fileSize - qint64(sizeof(ArchiveHeader))) / qint64(sizeof(ArchiveRecord));
+    m_sortedCount = qMin<qsizetype>(header.sortedCount, m_count);
+
+    m_lastTimestamp = m_sortedCount > 0 ? m_records[m_sortedCount - 1].timestamp
+                                        : std::numeric_limits<qint64>::min();
+    for (qsizetype i = m_sortedCount; i < m_count; ++i)
+        m_lastTimestamp = qMax(m_lastTimestamp, m_records[i].timestamp);
+
+    m_sparseIndex.clear();
+    m_sparseIndex.reserve(m_sortedCount / IndexStride + 1);
+    for (qsizetype i = 0; i < m_sortedCount; i += IndexStride)
+        m_sparseIndex.append(m_records[i].timestamp);
+    return true;
+}
+
+void ArchiveSegment::close()
+{
+    if (m_map)
+        m_file.unmap(m_map);
+    m_map = nullptr;
+    m_records = nullptr;
+    m_count = 0;
+    m_sortedCount = 0;
+    m_lastTimestamp = std::numeric_limits<qint64>::min();
+    m_sparseIndex.clear();
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+qsizetype ArchiveSegment::lowerBound(qint64 timestamp) const
+{
+    // Rzadki indeks wskazuje blok, dokładna pozycja szukana tylko w jego obrębie
+    const qsizetype block = std::lower_bound(m_sparseIndex.cbegin(), m_sparseIndex.cend(), timestamp)
+                            - m_sparseIndex.cbegin();
+    if (block == 0)
+        return 0;
+
+    const ArchiveRecord *first = m_records + (block - 1) * IndexStride;
+    const ArchiveRecord *last = m_records + qMin(block * IndexStride, m_sortedCount);
+    const ArchiveRecord *it = std::lower_bound(first, last, timestamp,
+                                               [](const ArchiveRecord &record, qint64 ts) {
+                                                   return record.timestamp < ts;
+                                               });
+    return it - m_records;
+}
+
+const ArchiveRecord *ArchiveSegment::find(qint64 timestamp) const
+{
+    // Najnowsza korekta ma pierwszeństwo przed prefiksem
+    for (qsizetype i = m_count - 1; i >= m_sortedCount; --i) {
+        if (m_records[i].timestamp == timestamp)
+            return &m_records[i];
+    }
+
+    const qsizetype pos = lowerBound(timestamp);
+    if (pos < m_sortedCount && m_records[pos].timestamp == timestamp)
+        return &m_records[pos];
+    return nullptr;
+}
+
+SeriesColumns ArchiveSegment::range(qint64 from, qint64 to) const
+{
+    SeriesColumns columns;
+    if (from > to || m_count == 0)
+        return columns;
+
+    const qsizetype begin = lowerBound(from);
+    const qsizetype end = to == std::numeric_limits<qint64>::max() ? m_sortedCount : lowerBound(to + 1);
+
+    QMap<qint64, ArchiveRecord> tail;
+    for (qsizetype i = m_sortedCount; i < m_count; ++i) {
+        const ArchiveRecord &record = m_records[i];
+        if (record.timestamp >= from && record.timestamp <= to)
+            tail.insert(record.timestamp, record);
+    }
+
+    columns.reserve(end - begin + tail.size());
+    auto tailIt = tail.cbegin();
+    for (qsizetype i = begin; i < end; ++i) {
+        const ArchiveRecord &record = m_records[i];
+        while (tailIt != tail.cend() && tailIt.key() < record.timestamp) {
+            columns.append(tailIt->timestamp, tailIt->value, tailIt->flags & ValidFlag);
+            ++tailIt;
+        }
+        if (tailIt != tail.cend() && tailIt.key() == record.timestamp) {
+            columns.append(tailIt->timestamp, tailIt->value, tailIt->flags & ValidFlag);
+            ++tailIt;
+            continue;
+        }
+        columns.append(record.timestamp, record.value, record.flags & ValidFlag);
+    }
+    for (; tailIt != tail.cend(); ++tailIt)
+        columns.append(tailIt->timestamp, tailIt->value, tailIt->flags & ValidFlag);
+    return columns;
+}
+
+MeasurementArchive::MeasurementArchive(const QString &directory)
+    : m_directory(directory)
+{
+}
+
+QString MeasurementArchive::pathFor(const SeriesKey &key) const
+{
+    return QString("%1/%2_%3.gma").arg(m_directory).arg(key.stationId).arg(key.paramCode);
+}
+
+MeasurementArchive::IngestStats MeasurementArchive::ingest(const SeriesKey &key, const SeriesColumns &columns)
+{
+    TraceSpan span("archive ingest", "io");
+    IngestStats stats;
+    if (columns.isEmpty())
+        return stats;
+
+    if (!QDir().mkpath(m_directory)) {
+        stats.error = QString("Nie udało się utworzyć katalogu archiwum %1").arg(m_directory);
+        return stats;
+    }
+    const QString path = pathFor(key);
+
+    // Plik krótszy od nagłówka to ślad przerwanego tworzenia segmentu - nie ma w nim pomiarów
+    const bool exists = QFileInfo(path).size() >= qint64(sizeof(ArchiveHeader));
+
+    QVector<ArchiveRecord> newRecords;
+    qsizetype count = 0;
+    qsizetype sortedCount = 0;
+    {
+        ArchiveSegment segment(path);
+        if (exists && !segment.open()) {
+            // Nieznana wersja, uszkodzony nagłówek albo nieudane mapowanie: historia zostaje nietknięta
+            stats.error = QString("Nie udało się odczytać segmentu archiwum %1").arg(path);
+            qDebug() << stats.error;
+            return stats;
+        }
+        qint64 last = exists ? segment.lastTimestamp() : std::numeric_limits<qint64>::min();
+        count = segment.size();
+        sortedCount = segment.sortedCount();
+
+        for (qsizetype i = 0; i < columns.size(); ++i) {
+            const qint64 ts = columns.timestamp(i);
+            const bool valid = columns.isValid(i);
+            const float value = columns.value(i);
+            const ArchiveRecord record{ts, value, valid ? ValidFlag : 0u};
+
+            if (ts > last) {
+                newRecords.append(record);
+                last = ts;
+                ++stats.appended;
+                continue;
+            }
+
+            // Godziny nakładające się z poprzednim pobraniem: pomijamy identyczne
+            // i nie nadpisujemy ważnego pomiaru brakującym
+            const ArchiveRecord *existing = segment.find(ts);
+            if (existing && (sameReading(*existing, value, valid) || ((existing->flags & ValidFlag) && !valid))) {
+                ++stats.duplicates;
+                continue;
+            }
+            newRecords.append(record);
+            ++stats.corrected;
+        }
+    }
+
+    if (newRecords.isEmpty())
+        return stats;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qDebug() << "Nie udało się otworzyć segmentu archiwum:" << path;
+        IngestStats failed;
+        failed.error = QString("%1: %2").arg(path, file.errorString());
+        return failed;
+    }
+
+    // Nowe godziny przedłużają posortowany prefiks tylko, gdy nie ma w nim korekt
+    const bool extendsPrefix = stats.corrected == 0 && sortedCount == count;
+    bool written = true;
+    if (!exists) {
+        // Nowy plik - zaczynamy od pustego nagłówka
+        const ArchiveHeader header = makeHeader(0);
+        written = file.resize(0)
+                  && file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header));
+    }
+
+    // Rekordy najpierw, nagłówek na końcu - po przerwanym zapisie prefiks jest co najwyżej krótszy
+    const qint64 recordBytes = newRecords.size() * qint64(sizeof(ArchiveRecord));
+    written = written && file.seek(sizeof(ArchiveHeader) + count * qint64(sizeof(ArchiveRecord)))
+              && file.write(reinterpret_cast<const char *>(newRecords.constData()), recordBytes) == recordBytes;
+
+    if (written && extendsPrefix) {
+        const ArchiveHeader header = makeHeader(count + newRecords.size());
+        written = file.seek(0)
+                  && file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header));
+    }
+    written = file.flush() && written;
+    if (!written) {
+        stats.error = QString("%1: %2").arg(path, file.errorString());
+        qDebug() << "Nie udało się zapisać segmentu archiwum:" << stats.error;
+        return stats;
+    }
+    file.close();
+
+    // Korekty w ogonie spowalniają każdy kolejny ingest i odczyt - scalamy je od razu,
+    // żeby następne godziny znów przedłużały posortowany prefiks
+    if (!extendsPrefix) {
+        QString compactError;
+        if (!compact(key, &compactError)) {
+            stats.error = compactError;
+            qDebug() << "Nie udało się scalić segmentu archiwum:" << stats.error;
+        }
+    }
+
+    return stats;
+}
+
+SeriesColumns MeasurementArchive::read(const SeriesKey &key, qint64 from, qint64 to) const
+{
+    ArchiveSegment segment(pathFor(key));
+    if (!segment.open())
+        return SeriesColumns();
+    return segment.range(from, to);
+}
+
+bool MeasurementArchive::compact(const SeriesKey &key, QString *error)
+{
+    const QString path = pathFor(key);
+    SeriesColumns merged;
+    {
+        ArchiveSegment segment(path);
+        if (!segment.open()) {
+            if (error)
+                *error = QString("Nie udało się odczytać segmentu archiwum %1").arg(path);
+            return false;
+        }
+        if (segment.sortedCount() == segment.size())
+            return true;
+        merged = segment.range(std::numeric_limits<qint64>::min(), std::numeric_limits<qint64>::max());
+    }
+
+    QVector<ArchiveRecord> records;
+    records.reserve(merged.size());
+    for (qsizetype i = 0; i < merged.size(); ++i)
+        records.append(ArchiveRecord{merged.timestamp(i), merged.value(i), merged.isValid(i) ? ValidFlag : 0u});
+
+    // Nowy segment powstaje obok i podmienia stary atomowo. Podmiana może się nie udać,
+    // gdy inny czytelnik wciąż ma plik zmapowany (Windows) - stary segment zostaje wtedy ważny
+    QSaveFile file(path);
+    const qint64 recordBytes = records.size() * qint64(sizeof(ArchiveRecord));
+    const ArchiveHeader header = makeHeader(records.size());
+    const bool written = file.open(QIODevice::WriteOnly)
+                         && file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header))
+                         && file.write(reinterpret_cast<const char *>(records.constData()), recordBytes) == recordBytes;
+    if (!written) {
+        if (error)
+            *error = QString("%1: %2").arg(path, file.errorString());
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()) {
+        if (error)
+            *error = QString("%1: %2").arg(path, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+QList<SeriesKey> MeasurementArchive::keys() const
+{
+    QList<SeriesKey> result;
+    const QStringList files = QDir(m_directory).entryList(QStringList() << "*.gma", QDir::Files);
+    for (const QString &fileName : files) {
+        const QString base = fileName.chopped(4);
+        const int separator = base.indexOf('_');
+        if (separator <= 0)
+            continue;
+        bool ok = false;
+        const int stationId = base.left(separator).toInt(&ok);
+        if (ok)
+            result.append(SeriesKey{stationId, base.mid(separator + 1)});
+    }
+    return result;
+}
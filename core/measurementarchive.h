@@ -0,0 +1,107 @@
+#ifndef MEASUREMENTARCHIVE_H
+#define MEASUREMENTARCHIVE_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <limits>
+#include "seriesstore.h"
+
+/**
+ * @brief Rekord archiwum: jeden pomiar godzinowy (16 bajtów, natywna kolejność bajtów).
+ */
+struct ArchiveRecord
+{
+    qint64 timestamp;   ///< Czas pomiaru w ms od epoki.
+    float value;        ///< Wartość (0 dla brakującego odczytu).
+    quint32 flags;      ///< Bit 0: pomiar ważny.
+};
+static_assert(sizeof(ArchiveRecord) == 16, "ArchiveRecord musi mieć 16 bajtów");
+
+/**
+ * @brief Nagłówek pliku segmentu (32 bajty).
+ * @details Liczba rekordów wynika z rozmiaru pliku; sortedCount to długość posortowanego,
+ * bezduplikatowego prefiksu. Rekordy za nim to korekty dopisane w trakcie ingestu.
+ */
+struct ArchiveHeader
+{
+    char magic[4];          ///< "GIOA".
+    quint16 version;        ///< Wersja formatu.
+    quint16 recordSize;     ///< sizeof(ArchiveRecord).
+    quint64 sortedCount;    ///< Liczba rekordów w posortowanym prefiksie.
+    quint64 reserved[2];
+};
+static_assert(sizeof(ArchiveHeader) == 32, "ArchiveHeader musi mieć 32 bajty");
+
+/**
+ * @brief Segment archiwum jednej serii (stacja, parametr) otwarty przez mmap.
+ * @details Przy otwarciu budowany jest rzadki indeks czasu (co IndexStride rekordów),
+ * dzięki któremu odczyt zakresu dotyka tylko potrzebnych stron pliku.
+ */
+class ArchiveSegment
+{
+public:
+    static constexpr qsizetype IndexStride = 64;
+
+    explicit ArchiveSegment(const QString &path);
+    ~ArchiveSegment();
+
+    bool open();
+    void close();
+
+    qsizetype size() const { return m_count; }
+    qsizetype sortedCount() const { return m_sortedCount; }
+    const ArchiveRecord *records() const { return m_records; }
+    qint64 lastTimestamp() const { return m_lastTimestamp; }
+
+    const ArchiveRecord *find(qint64 timestamp) const;
+    SeriesColumns range(qint64 from, qint64 to) const;
+
+private:
+    qsizetype lowerBound(qint64 timestamp) const;
+
+    QFile m_file;
+    uchar *m_map = nullptr;
+    const ArchiveRecord *m_records = nullptr;
+    qsizetype m_count = 0;
+    qsizetype m_sortedCount = 0;
+    qint64 m_lastTimestamp = 0;
+    QVector<qint64> m_sparseIndex;  ///< Znacznik czasu co IndexStride rekordów prefiksu.
+};
+
+/**
+ * @brief Trwałe, dopisywane archiwum historycznych pomiarów.
+ * @details Każda para (stacja, parametr) ma własny plik segmentu w katalogu archiwum.
+ * Ingest dopisuje tylko nowe godziny; pomiary, które już są w archiwum z tą samą wartością,
+ * są pomijane, a zmienione dopisywane jako korekty. Ingest, który dopisał korektę, od razu
+ * scala ją z prefiksem (kompakcja), więc ogon nieposortowanych rekordów pozostaje pusty.
+ */
+class MeasurementArchive
+{
+public:
+    struct IngestStats {
+        int appended = 0;       ///< Nowe pomiary dopisane na końcu.
+        int corrected = 0;      ///< Korekty istniejących godzin.
+        int duplicates = 0;     ///< Pomiary pominięte jako duplikaty.
+        QString error;          ///< Opis błędu zapisu; pusty przy powodzeniu.
+
+        bool ok() const { return error.isEmpty(); }
+    };
+
+    explicit MeasurementArchive(const QString &directory = "archiwum");
+
+    IngestStats ingest(const SeriesKey &key, const SeriesColumns &columns);
+    SeriesColumns read(const SeriesKey &key,
+                       qint64 from = std::numeric_limits<qint64>::min(),
+                       qint64 to = std::numeric_limits<qint64>::max()) const;
+    bool compact(const SeriesKey &key, QString *error = nullptr);
+
+    QList<SeriesKey> keys() const;
+    QString pathFor(const SeriesKey &key) const;
+    QString directory() const { return m_directory; }
+
+private:
+    QString m_directory;
+};
+
+#endif // MEASUREMENTARCHIVE_H
@@ -0,0 +1,171 @@
+#include "regionreport.h"
+#include "seriesanalysis.h"
+#include <QHash>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double SketchGamma = 1.01;    // względna szerokość przedziału szkicu
+constexpr double SketchMinValue = 0.01; // mniejsze wartości trafiają do przedziału zerowego
+constexpr int SketchBins = 1620;        // pokrywa zakres 0,01 .. ~1e5
+
+const double LogGamma = std::log(SketchGamma);
+
+int sketchBin(float value)
+{
+    const int bin = int(std::floor(std::log(value / SketchMinValue) / LogGamma));
+    return qBound(0, bin, SketchBins - 1);
+}
+
+using RegionPartial = QHash<QString, RegionAggregate>;
+
+} // namespace
+
+void ValueSketch::add(float value)
+{
+    ++m_count;
+    if (!(value >= SketchMinValue)) {
+        ++m_zeros;
+        return;
+    }
+    if (m_bins.isEmpty())
+        m_bins.fill(0, SketchBins);
+    ++m_bins[sketchBin(value)];
+}
+
+void ValueSketch::merge(const ValueSketch &other)
+{
+    m_count += other.m_count;
+    m_zeros += other.m_zeros;
+    if (other.m_bins.isEmpty())
+        return;
+    if (m_bins.isEmpty()) {
+        m_bins = other.m_bins;
+        return;
+    }
+    for (int i = 0; i < SketchBins; ++i)
+        m_bins[i] += other.m_bins[i];
+}
+
+double ValueSketch::quantile(double q) const
+{
+    if (m_count == 0)
+        return 0.0;
+
+    const qint64 rank = qBound<qint64>(0, qint64(std::ceil(q * m_count)) - 1, m_count - 1);
+    qint64 seen = m_zeros;
+    if (rank < seen)
+        return 0.0;
+    for (int i = 0; i < m_bins.size(); ++i) {
+        seen += m_bins[i];
+        if (rank < seen) {
+            // Środek geometryczny przedziału [gamma^i, gamma^(i+1)) * min
+            return SketchMinValue * std::pow(SketchGamma, i + 0.5);
+        }
+    }
+    return 0.0;
+}
+
+void RegionAggregate::merge(const RegionAggregate &other)
+{
+    stats.merge(other.stats);
+    sketch.merge(other.sketch);
+    stations += other.stations;
+}
+
+QString RegionReport::regionOf(const Station &station, RegionLevel level)
+{
+    // Nazwy gmin i powiatów powtarzają się w różnych województwach, więc klucz zawiera całą ścieżkę
+    switch (level) {
+    case RegionLevel::Province:
+        return station.provinceName;
+    case RegionLevel::District:
+        if (station.districtName.isEmpty())
+            return QString();
+        return station.provinceName + '/' + station.districtName;
+    case RegionLevel::Commune:
+        if (station.communeName.isEmpty())
+            return QString();
+        return station.provinceName + '/' + station.districtName + '/' + station.communeName;
+    }
+    return QString();
+}
+
+QList<RegionRow> RegionReport::compute(const QList<Station> &stations, const QString &paramCode, RegionLevel level,
+                                       const SeriesSource &source, qint64 from, qint64 to)
+{
+    double threshold = 0.0;
+    const float limit = SeriesAnalysis::exceedanceThreshold(paramCode, &threshold)
+                            ? float(threshold) : std::numeric_limits<float>::infinity();
+
+    // Etap map: każda stacja osobno, w puli wątków; etap reduce: scalanie agregatów regionów
+    const auto map = [&](const Station &station) {
+        RegionPartial partial;
+        const SeriesColumns series = source(SeriesKey{station.id, paramCode}, from, to);
+        if (series.isEmpty())
+            return partial;
+
+        RegionAggregate aggregate{RunningAggregate::fromColumns(series, limit), ValueSketch(), 1};
+        for (qsizetype i = 0; i < series.size(); ++i) {
+            if (series.isValid(i))
+                aggregate.sketch.add(series.value(i));
+        }
+        if (aggregate.stats.count() > 0)
+            partial.insert(regionOf(station, level), aggregate);
+        return partial;
+    };
+    const auto reduce = [](RegionPartial &result, const RegionPartial &partial) {
+        for (auto it = partial.cbegin(); it != partial.cend(); ++it)
+            result[it.key()].merge(it.value());
+    };
+
+    const RegionPartial regions = QtConcurrent::blockingMappedReduced<RegionPartial>(
+        stations, map, reduce, QtConcurrent::UnorderedReduce);
+
+    QList<RegionRow> rows;
+    rows.reserve(regions.size());
+    for (auto it = regions.cbegin(); it != regions.cend(); ++it) {
+        const RegionAggregate &aggregate = it.value();
+        RegionRow row;
+        row.region = it.key().isEmpty() ? QString("(brak)") : it.key();
+        row.stations = aggregate.stations;
+        row.count = aggregate.stats.count();
+        row.mean = aggregate.stats.mean();
+        row.p50 = aggregate.sketch.quantile(0.5);
+        row.p90 = aggregate.sketch.quantile(0.9);
+        row.p98 = aggregate.sketch.quantile(0.98);
+        row.max = aggregate.stats.max();
+        row.exceedances = aggregate.stats.exceedances();
+        rows.append(row);
+    }
+    std::sort(rows.begin(), rows.end(), [](const RegionRow &a, const RegionRow &b) {
+        return a.region.localeAwareCompare(b.region) < 0;
+    });
+    return rows;
+}
+
+QString RegionReport::format(const QString &paramCode, RegionLevel level, const QList<RegionRow> &rows)
+{
+    const QString levelName = level == RegionLevel::Province ? "województwo"
+                              : level == RegionLevel::District ? "powiat" : "gmina";
+    if (rows.isEmpty())
+        return QString("Brak danych dla parametru %1.\n").arg(paramCode);
+
+    QString report = QString("Raport regionalny: %1 (%2)\n").arg(paramCode, levelName);
+    report += "Region\tStacje\tPomiary\tŚrednia\tMediana\tP90\tP98\tMaks.\tPrzekroczenia\n";
+    for (const RegionRow &row : rows) {
+        report += QString("%1\t%2\t%3\t%4\t%5\t%6\t%7\t%8\t%9\n")
+                      .arg(row.region)
+                      .arg(row.stations)
+                      .arg(row.count)
+                      .arg(QString::number(row.mean, 'f', 1))
+                      .arg(QString::number(row.p50, 'f', 1))
+                      .arg(QString::number(row.p90, 'f', 1))
+                      .arg(QString::number(row.p98, 'f', 1))
+                      .arg(QString::number(row.max, 'f', 1))
+                      .arg(row.exceedances);
+    }
+    return report;
+}
@@ -0,0 +1,93 @@
+#ifndef REGIONREPORT_H
+#define REGIONREPORT_H
+
+#include <QList>
+#include <QString>
+#include <QVector>
+#include <limits>
+#include "giosdata.h"
+#include "runningaggregate.h"
+#include "seriesstore.h"
+
+/**
+ * @brief Poziom podziału administracyjnego, po którym grupowane są stacje.
+ */
+enum class RegionLevel {
+    Province,   ///< Województwo.
+    District,   ///< Powiat.
+    Commune     ///< Gmina.
+};
+
+/**
+ * @brief Łączalny szkic rozkładu wartości do wyznaczania percentyli.
+ * @details Przedziały rosną geometrycznie (co 1%), więc błąd względny percentyla nie
+ * przekracza 0,5% w całym zakresie stężeń. Szkice z różnych wątków scala się przez
+ * dodanie liczników.
+ */
+class ValueSketch
+{
+public:
+    void add(float value);
+    void merge(const ValueSketch &other);
+    qint64 count() const { return m_count; }
+    /**
+     * @brief Zwraca przybliżony kwantyl rzędu q (0..1); 0 dla pustego szkicu.
+     */
+    double quantile(double q) const;
+
+private:
+    QVector<qint64> m_bins;     ///< Liczniki przedziałów, tworzone przy pierwszym pomiarze.
+    qint64 m_zeros = 0;         ///< Wartości niedodatnie i bliskie zera.
+    qint64 m_count = 0;
+};
+
+/**
+ * @brief Częściowy agregat jednego regionu: statystyki, szkic rozkładu i liczba stacji.
+ */
+struct RegionAggregate
+{
+    RunningAggregate stats = RunningAggregate();
+    ValueSketch sketch;
+    int stations = 0;
+
+    void merge(const RegionAggregate &other);
+};
+
+/**
+ * @brief Wiersz raportu regionalnego.
+ */
+struct RegionRow
+{
+    QString region;             ///< Nazwa regionu; powiat i gmina poprzedzone nadrzędnymi (województwo/powiat/gmina).
+    int stations = 0;           ///< Liczba stacji z danymi.
+    qint64 count = 0;           ///< Liczba ważnych pomiarów.
+    double mean = 0.0;          ///< Średnia wartość.
+    double p50 = 0.0;           ///< Mediana.
+    double p90 = 0.0;           ///< 90. percentyl.
+    double p98 = 0.0;           ///< 98. percentyl.
+    double max = 0.0;           ///< Wartość maksymalna.
+    qint64 exceedances = 0;     ///< Liczba pomiarów powyżej progu (jeśli parametr go ma).
+};
+
+/**
+ * @brief Równoległe grupowanie serii po województwach, powiatach lub gminach.
+ * @details Każda stacja jest przetwarzana w puli wątków niezależnie: odczyt serii,
+ * agregat i szkic percentyli. Częściowe agregaty regionów są następnie scalane.
+ * Źródło serii musi być bezpieczne wątkowo (np. MeasurementArchive::read).
+ */
+namespace RegionReport
+{
+using SeriesSource = ::SeriesSource;
+
+/**
+ * @brief Klucz regionu stacji: województwo, "województwo/powiat" albo "województwo/powiat/gmina".
+ */
+QString regionOf(const Station &station, RegionLevel level);
+QList<RegionRow> compute(const QList<Station> &stations, const QString &paramCode, RegionLevel level,
+                         const SeriesSource &source,
+                         qint64 from = std::numeric_limits<qint64>::min(),
+                         qint64 to = std::numeric_limits<qint64>::max());
+QString format(const QString &paramCode, RegionLevel level, const QList<RegionRow> &rows);
+}
+
+#endif // REGIONREPORT_H
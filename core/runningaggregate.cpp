@@ -0,0 +1,97 @@
+#include "runningaggregate.h"
+#include "seriesstore.h"
+#include <cmath>
+
+namespace {
+
+constexpr double MsPerHour = 3600000.0;
+
+} // namespace
+
+void RunningAggregate::add(qint64 timestamp, float value)
+{
+    const double x = timestamp / MsPerHour;
+    const double y = value;
+
+    ++m_count;
+    const double dx = x - m_meanX;
+    const double dy = y - m_meanY;
+    m_meanX += dx / m_count;
+    m_meanY += dy / m_count;
+    m_m2X += dx * (x - m_meanX);
+    m_m2Y += dy * (y - m_meanY);
+    m_cXY += dx * (y - m_meanY);
+
+    m_min = qMin(m_min, value);
+    m_max = qMax(m_max, value);
+    if (value > m_threshold)
+        ++m_exceedances;
+}
+
+void RunningAggregate::merge(const RunningAggregate &other)
+{
+    if (other.m_count == 0)
+        return;
+    if (m_count == 0) {
+        const float threshold = m_threshold;
+        *this = other;
+        m_threshold = threshold;
+        return;
+    }
+
+    const double na = m_count;
+    const double nb = other.m_count;
+    const double n = na + nb;
+    const double dx = other.m_meanX - m_meanX;
+    const double dy = other.m_meanY - m_meanY;
+
+    m_meanX += dx * nb / n;
+    m_meanY += dy * nb / n;
+    m_m2X += other.m_m2X + dx * dx * na * nb / n;
+    m_m2Y += other.m_m2Y + dy * dy * na * nb / n;
+    m_cXY += other.m_cXY + dx * dy * na * nb / n;
+
+    m_count += other.m_count;
+    m_min = qMin(m_min, other.m_min);
+    m_max = qMax(m_max, other.m_max);
+    m_exceedances += other.m_exceedances;
+}
+
+RunningAggregate RunningAggregate::fromMoments(const SeriesMoments &moments, qint64 origin, float threshold)
+{
+    RunningAggregate aggregate(threshold);
+    if (moments.count == 0)
+        return aggregate;
+
+    // Sumy surowe z jądra wektorowego przeliczamy na momenty centralne
+    const double n = double(moments.count);
+    aggregate.m_count = moments.count;
+    aggregate.m_min = moments.min;
+    aggregate.m_max = moments.max;
+    aggregate.m_exceedances = moments.exceedances;
+    aggregate.m_meanY = moments.sum / n;
+    aggregate.m_meanX = moments.sumX / n + origin / MsPerHour;
+    aggregate.m_m2Y = qMax(0.0, moments.sumSquares - moments.sum * moments.sum / n);
+    aggregate.m_m2X = qMax(0.0, moments.sumXX - moments.sumX * moments.sumX / n);
+    aggregate.m_cXY = moments.sumXY - moments.sumX * moments.sum / n;
+    return aggregate;
+}
+
+RunningAggregate RunningAggregate::fromColumns(const SeriesColumns &series, float threshold,
+                                               qsizetype begin, qsizetype end)
+{
+    if (end < 0)
+        end = series.size();
+    if (begin >= end)
+        return RunningAggregate(threshold);
+
+    const qint64 origin = series.timestamp(begin);
+    const SeriesMoments moments = StatKernels::compute(series.timestamps(), series.values(), series.validity(),
+                                                       begin, end, origin, threshold);
+    return fromMoments(moments, origin, threshold);
+}
+
+double RunningAggregate::stddev() const
+{
+    return std::sqrt(variance());
+}
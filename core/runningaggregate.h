@@ -0,0 +1,54 @@
+#ifndef RUNNINGAGGREGATE_H
+#define RUNNINGAGGREGATE_H
+
+#include <QtGlobal>
+#include <limits>
+#include "statkernels.h"
+
+class SeriesColumns;
+
+/**
+ * @brief Łączalny stan agregatu serii: liczność, suma, min, max, wariancja i regresja.
+ * @details Wariancja i współczynniki regresji są liczone metodą Welforda (momenty centralne),
+ * więc dodanie pomiaru kosztuje O(1), a stany dla rozłącznych okien można scalać
+ * (wzory Chana) bez utraty dokładności. Oś X to czas w godzinach od epoki Unix.
+ */
+class RunningAggregate
+{
+public:
+    explicit RunningAggregate(float threshold = std::numeric_limits<float>::infinity())
+        : m_threshold(threshold) {}
+
+    void add(qint64 timestamp, float value);
+    void merge(const RunningAggregate &other);
+
+    static RunningAggregate fromMoments(const SeriesMoments &moments, qint64 origin, float threshold);
+    static RunningAggregate fromColumns(const SeriesColumns &series, float threshold,
+                                        qsizetype begin = 0, qsizetype end = -1);
+
+    qint64 count() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+    double sum() const { return m_meanY * m_count; }
+    double mean() const { return m_meanY; }
+    float min() const { return m_min; }
+    float max() const { return m_max; }
+    double variance() const { return m_count > 1 ? m_m2Y / (m_count - 1) : 0.0; }
+    double stddev() const;
+    qint64 exceedances() const { return m_exceedances; }
+    float threshold() const { return m_threshold; }
+    double slope() const { return m_m2X > 0.0 ? m_cXY / m_m2X : 0.0; }  ///< Zmiana wartości na godzinę.
+
+private:
+    float m_threshold;
+    qint64 m_count = 0;
+    float m_min = std::numeric_limits<float>::infinity();
+    float m_max = -std::numeric_limits<float>::infinity();
+    qint64 m_exceedances = 0;
+    double m_meanX = 0.0;   ///< Średni czas (h).
+    double m_meanY = 0.0;   ///< Średnia wartość.
+    double m_m2X = 0.0;     ///< Suma kwadratów odchyleń czasu.
+    double m_m2Y = 0.0;     ///< Suma kwadratów odchyleń wartości.
+    double m_cXY = 0.0;     ///< Suma iloczynów odchyleń (kowariancja × n).
+};
+
+#endif // RUNNINGAGGREGATE_H
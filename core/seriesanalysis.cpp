@@ -0,0 +1,97 @@
+#include "seriesanalysis.h"
+#include "statkernels.h"
+#include "tracer.h"
+#include <cmath>
+#include <limits>
+
+bool SeriesAnalysis::exceedanceThreshold(const QString &paramCode, double *threshold)
+{
+    if (paramCode == "PM10") {
+        *threshold = 25.0;
+        return true;
+    }
+    return false;
+}
+
+AnalysisResult SeriesAnalysis::analyze(const QString &paramCode, const SeriesColumns &series)
+{
+    TraceSpan span("analyze", "analysis");
+    double threshold = 0.0;
+    const bool hasThreshold = exceedanceThreshold(paramCode, &threshold);
+    // Jeden połączony przebieg wektorowego jądra zamiast osobnych pętli dla statystyk i trendu
+    const SeriesMoments moments = StatKernels::compute(series, hasThreshold ? float(threshold)
+                                                                           : std::numeric_limits<float>::infinity());
+    return fromMoments(paramCode, moments);
+}
+
+AnalysisResult SeriesAnalysis::fromMoments(const QString &paramCode, const SeriesMoments &moments)
+{
+    AnalysisResult result;
+    result.paramCode = paramCode;
+    result.hasThreshold = exceedanceThreshold(paramCode, &result.threshold);
+    result.count = int(moments.count);
+    if (result.count == 0)
+        return result;
+
+    result.min = moments.min;
+    result.max = moments.max;
+    result.mean = moments.mean();
+    if (moments.count > 1) {
+        const double m2 = moments.sumSquares - moments.sum * moments.sum / moments.count;
+        result.stddev = std::sqrt(qMax(0.0, m2) / (moments.count - 1));
+    }
+    result.exceedances = result.hasThreshold ? int(moments.exceedances) : 0;
+    // Regresja liniowa po czasie w godzinach, liczonym od pierwszego pomiaru
+    result.trend = moments.slope();
+    return result;
+}
+
+AnalysisResult SeriesAnalysis::fromAggregate(const QString &paramCode, const RunningAggregate &aggregate)
+{
+    AnalysisResult result;
+    result.paramCode = paramCode;
+    result.hasThreshold = exceedanceThreshold(paramCode, &result.threshold);
+    result.count = int(aggregate.count());
+    if (result.count == 0)
+        return result;
+
+    result.min = aggregate.min();
+    result.max = aggregate.max();
+    result.mean = aggregate.mean();
+    result.stddev = aggregate.stddev();
+    result.exceedances = result.hasThreshold ? int(aggregate.exceedances()) : 0;
+    result.trend = aggregate.slope();
+    return result;
+}
+
+QString SeriesAnalysis::format(const AnalysisResult &result)
+{
+    if (result.count == 0)
+        return QString("Brak dostępnych danych pomiarowych dla %1.\n\n").arg(result.paramCode);
+
+    QString analysis = QString(
+                           "Analiza danych dla parametru: %1\n"
+                           "Liczba pomiarów: %2\n"
+                           "Wartość minimalna: %3 µg/m³\n"
+                           "Wartość maksymalna: %4 µg/m³\n"
+                           "Średnia wartość: %5 µg/m³\n"
+                           "Odchylenie standardowe: %6 µg/m³\n"
+                           ).arg(result.paramCode)
+                           .arg(result.count)
+                           .arg(QString::number(result.min, 'f', 2))
+                           .arg(QString::number(result.max, 'f', 2))
+                           .arg(QString::number(result.mean, 'f', 2))
+                           .arg(QString::number(result.stddev, 'f', 2));
+
+    if (result.hasThreshold) {
+        analysis += QString(
+                        "Przekroczenia progu %1 µg/m³: %2 razy\n"
+                        "Procent przekroczeń: %3%\n"
+                        ).arg(result.threshold)
+                        .arg(result.exceedances)
+                        .arg(QString::number(result.exceedancePercent(), 'f', 2));
+    }
+
+    analysis += QString("Trend: %1\n\n").arg(result.trend > 0 ? "Wzrost" : result.trend < 0 ? "Spadek" : "Stabilny");
+    return analysis;
+}
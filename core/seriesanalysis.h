@@ -0,0 +1,43 @@
+#ifndef SERIESANALYSIS_H
+#define SERIESANALYSIS_H
+
+#include <QString>
+#include <QMetaType>
+#include "seriesstore.h"
+#include "statkernels.h"
+#include "runningaggregate.h"
+
+/**
+ * @brief Wynik analizy statystycznej jednej serii.
+ */
+struct AnalysisResult
+{
+    QString paramCode;          ///< Kod analizowanego parametru.
+    int count = 0;              ///< Liczba ważnych pomiarów.
+    double min = 0.0;           ///< Wartość minimalna.
+    double max = 0.0;           ///< Wartość maksymalna.
+    double mean = 0.0;          ///< Średnia wartość.
+    double stddev = 0.0;        ///< Odchylenie standardowe (próbkowe).
+    bool hasThreshold = false;  ///< Czy parametr ma próg przekroczeń.
+    double threshold = 0.0;     ///< Próg przekroczeń (np. 25 µg/m³ dla PM10).
+    int exceedances = 0;        ///< Liczba pomiarów powyżej progu.
+    double trend = 0.0;         ///< Nachylenie prostej regresji (wartość na godzinę).
+
+    double exceedancePercent() const { return count > 0 ? 100.0 * exceedances / count : 0.0; }
+};
+
+Q_DECLARE_METATYPE(AnalysisResult)
+
+/**
+ * @brief Analiza serii pomiarowych niezależna od GUI.
+ */
+namespace SeriesAnalysis
+{
+bool exceedanceThreshold(const QString &paramCode, double *threshold);
+AnalysisResult analyze(const QString &paramCode, const SeriesColumns &series);
+AnalysisResult fromMoments(const QString &paramCode, const SeriesMoments &moments);
+AnalysisResult fromAggregate(const QString &paramCode, const RunningAggregate &aggregate);
+QString format(const AnalysisResult &result);
+}
+
+#endif // SERIESANALYSIS_H
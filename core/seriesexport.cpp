@@ -0,0 +1,495 @@
+#include "seriesexport.h"
+#include <QDateTime>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <algorithm>
+#include <vector>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+/*
+ * Format binarny GIOX (little-endian):
+ *   nagłówek:   "GIOX", quint32 wersja (1)
+ *   blok serii: qint32 stationId, quint16 długość kodu parametru, kod (UTF-8), quint32 n,
+ *               qint64 timestamps[n], float values[n], quint64 validity[(n + 63) / 64]
+ * Długie serie są dzielone na kolejne bloki z tym samym kluczem.
+ */
+
+static_assert(Q_BYTE_ORDER == Q_LITTLE_ENDIAN, "Format GIOX zapisuje kolumny bezpośrednio z pamięci");
+
+namespace {
+
+constexpr qsizetype BufferSize = 256 * 1024;                // porcja przekazywana do kompresora i pliku
+constexpr qint64 WideWindowMs = 31LL * 24 * 3600 * 1000;    // okno czasowe układu wide
+constexpr qint64 SeriesWindowMs = 366LL * 24 * 3600 * 1000; // okno odczytu jednej serii (long, binary)
+constexpr qsizetype BinaryBlockPoints = 64 * 1024;          // wielokrotność 64 - bitmapa dzieli się bez przesunięć
+constexpr quint32 BinaryVersion = 1;
+
+/**
+ * @brief Bufor wyjściowy z opcjonalną kompresją, zapisywany do QSaveFile porcjami.
+ */
+class ExportSink
+{
+public:
+    explicit ExportSink(ExportOptions::Compression compression) : m_compression(compression) {}
+    ~ExportSink();
+
+    bool open(const QString &path, QString *error);
+    QByteArray &buffer() { return m_buffer; }
+    bool flushIfFull() { return m_buffer.size() < BufferSize || drain(false); }
+    bool finish(QString *error);
+    void cancel() { m_file.cancelWriting(); }
+    QString errorString() const { return m_error.isEmpty() ? m_file.errorString() : m_error; }
+
+private:
+    bool drain(bool last);
+    bool writeOut(const char *data, qsizetype size);
+
+    ExportOptions::Compression m_compression;
+    QSaveFile m_file;
+    QByteArray m_buffer;
+    QByteArray m_out;
+    QString m_error;
+#ifdef HAVE_ZLIB
+    z_stream m_zlib{};
+    bool m_zlibReady = false;
+#endif
+#ifdef HAVE_ZSTD
+    ZSTD_CCtx *m_zstd = nullptr;
+#endif
+};
+
+ExportSink::~ExportSink()
+{
+#ifdef HAVE_ZLIB
+    if (m_zlibReady)
+        deflateEnd(&m_zlib);
+#endif
+#ifdef HAVE_ZSTD
+    ZSTD_freeCCtx(m_zstd);
+#endif
+}
+
+bool ExportSink::open(const QString &path, QString *error)
+{
+    if (!SeriesExporter::isSupported(m_compression)) {
+        *error = "Wybrana kompresja nie jest dostępna w tej kompilacji";
+        return false;
+    }
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly)) {
+        *error = m_file.errorString();
+        return false;
+    }
+    m_buffer.reserve(BufferSize + 4096);
+    m_out.resize(BufferSize);
+
+#ifdef HAVE_ZLIB
+    if (m_compression == ExportOptions::Compression::Gzip) {
+        // windowBits 15 + 16: nagłówek i suma kontrolna gzip zamiast surowego zlib
+        if (deflateInit2(&m_zlib, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            *error = "Nie udało się zainicjować kompresji gzip";
+            return false;
+        }
+        m_zlibReady = true;
+    }
+#endif
+#ifdef HAVE_ZSTD
+    if (m_compression == ExportOptions::Compression::Zstd) {
+        m_zstd = ZSTD_createCCtx();
+        if (!m_zstd) {
+            *error = "Nie udało się zainicjować kompresji zstd";
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+bool ExportSink::writeOut(const char *data, qsizetype size)
+{
+    if (size > 0 && m_file.write(data, size) != size) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool ExportSink::drain(bool last)
+{
+    bool ok = true;
+    switch (m_compression) {
+    case ExportOptions::Compression::None:
+        ok = writeOut(m_buffer.constData(), m_buffer.size());
+        break;
+    case ExportOptions::Compression::Gzip:
+#ifdef HAVE_ZLIB
+    {
+        m_zlib.next_in = reinterpret_cast<Bytef *>(m_buffer.data());
+        m_zlib.avail_in = uInt(m_buffer.size());
+        int result = Z_OK;
+        do {
+            m_zlib.next_out = reinterpret_cast<Bytef *>(m_out.data());
+            m_zlib.avail_out = uInt(m_out.size());
+            result = deflate(&m_zlib, last ? Z_FINISH : Z_NO_FLUSH);
+            if (result == Z_STREAM_ERROR) {
+                m_error = "Błąd kompresji gzip";
+                return false;
+            }
+            ok = writeOut(m_out.constData(), m_out.size() - m_zlib.avail_out);
+        } while (ok && (last ? result != Z_STREAM_END : m_zlib.avail_out == 0));
+    }
+#endif
+        break;
+    case ExportOptions::Compression::Zstd:
+#ifdef HAVE_ZSTD
+    {
+        ZSTD_inBuffer in{m_buffer.constData(), size_t(m_buffer.size()), 0};
+        size_t remaining = 0;
+        do {
+            ZSTD_outBuffer out{m_out.data(), size_t(m_out.size()), 0};
+            remaining = ZSTD_compressStream2(m_zstd, &out, &in, last ? ZSTD_e_end : ZSTD_e_continue);
+            if (ZSTD_isError(remaining)) {
+                m_error = QString("Błąd kompresji zstd: %1").arg(ZSTD_getErrorName(remaining));
+                return false;
+            }
+            ok = writeOut(m_out.constData(), qsizetype(out.pos));
+        } while (ok && (last ? remaining != 0 : in.pos < in.size));
+    }
+#endif
+        break;
+    }
+    m_buffer.clear();
+    return ok;
+}
+
+bool ExportSink::finish(QString *error)
+{
+    if (!drain(true) || !m_file.commit()) {
+        *error = errorString();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Formatowanie dat "yyyy-MM-dd HH:mm:ss" z zapamiętanym początkiem doby.
+ */
+class DateFormatter
+{
+public:
+    void append(QByteArray &out, qint64 msecs)
+    {
+        if (msecs < m_dayStart || msecs >= m_dayEnd) {
+            const QDate date = QDateTime::fromMSecsSinceEpoch(msecs).date();
+            const QDateTime start = date.startOfDay();
+            m_dayStart = start.toMSecsSinceEpoch();
+            m_dayEnd = date.addDays(1).startOfDay().toMSecsSinceEpoch();
+            m_prefix = date.toString("yyyy-MM-dd ").toLatin1();
+            m_uniform = start.time() == QTime(0, 0) && m_dayEnd - m_dayStart == 24LL * 3600 * 1000;
+        }
+        if (!m_uniform) {
+            // Doba ze zmianą czasu: dokładne formatowanie przez QDateTime
+            out += QDateTime::fromMSecsSinceEpoch(msecs).toString("yyyy-MM-dd HH:mm:ss").toLatin1();
+            return;
+        }
+
+        const int seconds = int((msecs - m_dayStart) / 1000);
+        const char digits[8] = {
+            char('0' + seconds / 36000), char('0' + seconds / 3600 % 10), ':',
+            char('0' + seconds % 3600 / 600), char('0' + seconds % 3600 / 60 % 10), ':',
+            char('0' + seconds % 60 / 10), char('0' + seconds % 10)
+        };
+        out += m_prefix;
+        out.append(digits, sizeof(digits));
+    }
+
+private:
+    qint64 m_dayStart = 1;
+    qint64 m_dayEnd = 0;
+    QByteArray m_prefix;
+    bool m_uniform = false;
+};
+
+inline void appendValue(QByteArray &out, const SeriesColumns &series, qsizetype i)
+{
+    if (series.isValid(i))
+        out += QByteArray::number(series.value(i), 'g', 6);
+}
+
+template<typename T>
+void appendRaw(QByteArray &out, const T &value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+bool isCancelled(const std::atomic_bool *cancelled)
+{
+    return cancelled && cancelled->load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Ustala granice eksportu; przy otwartym zakresie z danych, czytając po jednej serii naraz.
+ * @return false, gdy w zakresie nie ma żadnych pomiarów.
+ */
+bool resolveRange(const ExportOptions &options, const SeriesSource &source, qint64 *first, qint64 *last)
+{
+    *first = options.from;
+    *last = options.to;
+    if (*first == std::numeric_limits<qint64>::min() || *last == std::numeric_limits<qint64>::max()) {
+        qint64 dataFirst = std::numeric_limits<qint64>::max();
+        qint64 dataLast = std::numeric_limits<qint64>::min();
+        for (const SeriesKey &key : options.keys) {
+            const SeriesColumns series = source(key, options.from, options.to);
+            if (!series.isEmpty()) {
+                dataFirst = qMin(dataFirst, series.timestamp(0));
+                dataLast = qMax(dataLast, series.timestamp(series.size() - 1));
+            }
+        }
+        *first = qMax(*first, dataFirst);
+        *last = qMin(*last, dataLast);
+    }
+    return *first <= *last;
+}
+
+bool writeLong(ExportSink &sink, const ExportOptions &options, const SeriesSource &source,
+               const SeriesExporter::ProgressCallback &progress, const std::atomic_bool *cancelled)
+{
+    DateFormatter dates;
+    QByteArray &out = sink.buffer();
+    out += "Stacja;Parametr;Data;Wartość\n";
+
+    qint64 first = 0;
+    qint64 last = 0;
+    const bool hasData = resolveRange(options, source, &first, &last);
+
+    const int total = int(options.keys.size());
+    for (int k = 0; k < total; ++k) {
+        const SeriesKey &key = options.keys[k];
+        const QByteArray prefix = QByteArray::number(key.stationId) + ';' + key.paramCode.toUtf8() + ';';
+        // Seria jest czytana oknami, więc długi zakres nie trafia do pamięci w całości
+        for (qint64 windowStart = first; hasData && windowStart <= last; windowStart += SeriesWindowMs) {
+            if (isCancelled(cancelled))
+                return false;
+            const qint64 windowEnd = last - windowStart < SeriesWindowMs ? last : windowStart + SeriesWindowMs - 1;
+            const SeriesColumns series = source(key, windowStart, windowEnd);
+            for (qsizetype i = 0; i < series.size(); ++i) {
+                if (!series.isValid(i))
+                    continue;   // brakujące odczyty pomijamy, jak dotychczasowy eksport CSV
+                out += prefix;
+                dates.append(out, series.timestamp(i));
+                out += ';';
+                appendValue(out, series, i);
+                out += '\n';
+                if (!sink.flushIfFull())
+                    return false;
+            }
+            if (windowEnd == last)
+                break;
+        }
+        if (progress)
+            progress(k + 1, total);
+    }
+    return true;
+}
+
+bool writeWide(ExportSink &sink, const ExportOptions &options, const SeriesSource &source,
+               const SeriesExporter::ProgressCallback &progress, const std::atomic_bool *cancelled)
+{
+    QByteArray &out = sink.buffer();
+    out += "Data";
+    for (const SeriesKey &key : options.keys)
+        out += ';' + QByteArray::number(key.stationId) + '_' + key.paramCode.toUtf8();
+    out += '\n';
+
+    qint64 first = 0;
+    qint64 last = 0;
+    if (!resolveRange(options, source, &first, &last))
+        return true;
+
+    DateFormatter dates;
+    const int total = int((last - first) / WideWindowMs + 1);
+    QVector<SeriesColumns> window(options.keys.size());
+    QVector<qsizetype> cursor(options.keys.size());
+    std::vector<qint64> timestamps;
+
+    for (int w = 0; w < total; ++w) {
+        if (isCancelled(cancelled))
+            return false;
+        const qint64 windowStart = first + w * WideWindowMs;
+        const qint64 windowEnd = qMin(last, windowStart + WideWindowMs - 1);
+
+        // Wiersze okna: suma znaczników czasu wszystkich serii
+        timestamps.clear();
+        for (qsizetype k = 0; k < options.keys.size(); ++k) {
+            window[k] = source(options.keys[k], windowStart, windowEnd);
+            cursor[k] = 0;
+            timestamps.insert(timestamps.end(), window[k].timestamps(), window[k].timestamps() + window[k].size());
+        }
+        std::sort(timestamps.begin(), timestamps.end());
+        timestamps.erase(std::unique(timestamps.begin(), timestamps.end()), timestamps.end());
+
+        for (qint64 ts : timestamps) {
+            dates.append(out, ts);
+            for (qsizetype k = 0; k < window.size(); ++k) {
+                out += ';';
+                const SeriesColumns &series = window[k];
+                if (cursor[k] < series.size() && series.timestamp(cursor[k]) == ts)
+                    appendValue(out, series, cursor[k]++);
+            }
+            out += '\n';
+            if (!sink.flushIfFull())
+                return false;
+        }
+        if (progress)
+            progress(w + 1, total);
+    }
+    return true;
+}
+
+bool writeBinary(ExportSink &sink, const ExportOptions &options, const SeriesSource &source,
+                 const SeriesExporter::ProgressCallback &progress, const std::atomic_bool *cancelled)
+{
+    QByteArray &out = sink.buffer();
+    out += "GIOX";
+    appendRaw(out, BinaryVersion);
+
+    qint64 first = 0;
+    qint64 last = 0;
+    const bool hasData = resolveRange(options, source, &first, &last);
+
+    const int total = int(options.keys.size());
+    for (int k = 0; k < total; ++k) {
+        const SeriesKey &key = options.keys[k];
+        const QByteArray code = key.paramCode.toUtf8();
+        for (qint64 windowStart = first; hasData && windowStart <= last; windowStart += SeriesWindowMs) {
+            if (isCancelled(cancelled))
+                return false;
+            const qint64 windowEnd = last - windowStart < SeriesWindowMs ? last : windowStart + SeriesWindowMs - 1;
+            const SeriesColumns series = source(key, windowStart, windowEnd);
+
+            for (qsizetype begin = 0; begin < series.size(); begin += BinaryBlockPoints) {
+                const quint32 count = quint32(qMin(BinaryBlockPoints, series.size() - begin));
+                appendRaw(out, qint32(key.stationId));
+                appendRaw(out, quint16(code.size()));
+                out += code;
+                appendRaw(out, count);
+                out.append(reinterpret_cast<const char *>(series.timestamps() + begin), count * sizeof(qint64));
+                out.append(reinterpret_cast<const char *>(series.values() + begin), count * sizeof(float));
+                out.append(reinterpret_cast<const char *>(series.validity() + begin / 64),
+                           (count + 63) / 64 * sizeof(quint64));
+                if (!sink.flushIfFull())
+                    return false;
+            }
+            if (windowEnd == last)
+                break;
+        }
+        if (progress)
+            progress(k + 1, total);
+    }
+    return true;
+}
+
+} // namespace
+
+SeriesExporter::SeriesExporter(QObject *parent)
+    : QObject(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<QString>::finished, this, [this]() {
+        const QString error = m_watcher.result();
+        emit finished(error.isEmpty(), error);
+    });
+}
+
+SeriesExporter::~SeriesExporter()
+{
+    cancel();
+    m_watcher.waitForFinished();
+}
+
+bool SeriesExporter::isSupported(ExportOptions::Compression compression)
+{
+    switch (compression) {
+    case ExportOptions::Compression::None:
+        return true;
+    case ExportOptions::Compression::Gzip:
+#ifdef HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case ExportOptions::Compression::Zstd:
+#ifdef HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+QString SeriesExporter::suffixFor(const ExportOptions &options)
+{
+    QString suffix = options.layout == ExportOptions::Layout::Binary ? ".giox" : ".csv";
+    if (options.compression == ExportOptions::Compression::Gzip)
+        suffix += ".gz";
+    else if (options.compression == ExportOptions::Compression::Zstd)
+        suffix += ".zst";
+    return suffix;
+}
+
+void SeriesExporter::start(const ExportOptions &options, const SeriesSource &source)
+{
+    cancel();
+    m_watcher.waitForFinished();
+    m_cancelled = false;
+    m_watcher.setFuture(QtConcurrent::run([this, options, source]() {
+        // Sygnał emitowany z wątku roboczego trafia do odbiorców przez kolejkę zdarzeń
+        return run(options, source, [this](int done, int total) { emit progress(done, total); }, &m_cancelled);
+    }));
+}
+
+void SeriesExporter::cancel()
+{
+    m_cancelled = true;
+}
+
+QString SeriesExporter::run(const ExportOptions &options, const SeriesSource &source,
+                            const ProgressCallback &progress, const std::atomic_bool *cancelled)
+{
+    ExportSink sink(options.compression);
+    QString error;
+    if (!sink.open(options.path, &error))
+        return error;
+
+    bool ok = false;
+    switch (options.layout) {
+    case ExportOptions::Layout::LongCsv:
+        ok = writeLong(sink, options, source, progress, cancelled);
+        break;
+    case ExportOptions::Layout::WideCsv:
+        ok = writeWide(sink, options, source, progress, cancelled);
+        break;
+    case ExportOptions::Layout::Binary:
+        ok = writeBinary(sink, options, source, progress, cancelled);
+        break;
+    }
+
+    if (!ok) {
+        if (isCancelled(cancelled)) {
+            sink.cancel();
+            return QString("Eksport przerwany");
+        }
+        // Komunikat odczytujemy przed cancelWriting(), które zeruje stan pliku.
+        error = sink.errorString();
+        sink.cancel();
+        return error.isEmpty() ? QString("Błąd zapisu pliku eksportu") : error;
+    }
+    if (!sink.finish(&error))
+        return error;
+    return QString();
+}
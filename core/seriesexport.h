@@ -0,0 +1,89 @@
+#ifndef SERIESEXPORT_H
+#define SERIESEXPORT_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QList>
+#include <QString>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include "seriesstore.h"
+
+/**
+ * @brief Parametry eksportu serii pomiarowych.
+ */
+struct ExportOptions
+{
+    /**
+     * @brief Układ pliku wynikowego.
+     */
+    enum class Layout {
+        LongCsv,    ///< Wiersz na pomiar: stacja;parametr;data;wartość.
+        WideCsv,    ///< Wiersz na godzinę, kolumna na parę (stacja, parametr).
+        Binary      ///< Kolumnowy format binarny GIOX (opis w seriesexport.cpp).
+    };
+
+    /**
+     * @brief Kompresja strumienia wyjściowego.
+     */
+    enum class Compression {
+        None,
+        Gzip,       ///< Wymaga zlib (HAVE_ZLIB).
+        Zstd        ///< Wymaga libzstd (HAVE_ZSTD).
+    };
+
+    QString path;                                           ///< Plik docelowy.
+    QList<SeriesKey> keys;                                  ///< Eksportowane serie.
+    qint64 from = std::numeric_limits<qint64>::min();       ///< Początek zakresu (ms od epoki).
+    qint64 to = std::numeric_limits<qint64>::max();         ///< Koniec zakresu, włącznie.
+    Layout layout = Layout::LongCsv;
+    Compression compression = Compression::None;
+};
+
+/**
+ * @brief Strumieniowy eksport serii do CSV lub formatu binarnego, w wątku roboczym.
+ * @details Serie są odczytywane ze źródła w oknach czasowych (układ wide: każde okno
+ * po wszystkich seriach naraz), formatowane do bufora o stałym rozmiarze i zapisywane
+ * przez opcjonalny kompresor do QSaveFile. Przy zakresie zamkniętym pamięć nie zależy
+ * od długości zakresu ani liczby stacji; zakres otwarty wymaga wcześniej jednego pełnego
+ * odczytu każdej serii, by ustalić granice. Plik docelowy pojawia się dopiero po udanym zakończeniu.
+ */
+class SeriesExporter : public QObject
+{
+    Q_OBJECT
+public:
+    using ProgressCallback = std::function<void(int done, int total)>;
+
+    explicit SeriesExporter(QObject *parent = nullptr);
+    ~SeriesExporter();
+
+    static bool isSupported(ExportOptions::Compression compression);
+    static QString suffixFor(const ExportOptions &options);
+
+    /**
+     * @brief Rozpoczyna eksport w puli wątków; źródło musi być bezpieczne wątkowo.
+     */
+    void start(const ExportOptions &options, const SeriesSource &source);
+    void cancel();
+    bool isRunning() const { return m_watcher.isRunning(); }
+
+    /**
+     * @brief Wykonuje eksport synchronicznie w bieżącym wątku.
+     * @param cancelled Opcjonalna flaga przerwania, sprawdzana między porcjami danych.
+     * @return Pusty tekst przy powodzeniu, w przeciwnym razie opis błędu.
+     */
+    static QString run(const ExportOptions &options, const SeriesSource &source,
+                       const ProgressCallback &progress = ProgressCallback(),
+                       const std::atomic_bool *cancelled = nullptr);
+
+signals:
+    void progress(int done, int total);
+    void finished(bool ok, const QString &error);
+
+private:
+    QFutureWatcher<QString> m_watcher;
+    std::atomic_bool m_cancelled{false};
+};
+
+#endif // SERIESEXPORT_H
@@ -0,0 +1,113 @@
+#include "seriesrollup.h"
+#include "seriesstore.h"
+#include <QDateTime>
+#include <algorithm>
+
+namespace {
+
+constexpr qint64 MsPerHour = 3600 * 1000;
+constexpr qint64 MsPerDay = 24 * MsPerHour;
+
+} // namespace
+
+bool SeriesRollup::add(qint64 timestamp, float value)
+{
+    // Pomiar nie starszy niż ostatnia doba nie jest też starszy niż ostatni miesiąc
+    if (!addTo(m_daily, RollupLevel::Daily, timestamp, value))
+        return false;
+    addTo(m_monthly, RollupLevel::Monthly, timestamp, value);
+    return true;
+}
+
+bool SeriesRollup::addTo(QVector<RollupBucket> &buckets, RollupLevel level, qint64 timestamp, float value)
+{
+    if (buckets.isEmpty() || timestamp >= buckets.last().end)
+        buckets.append(bucketFor(level, timestamp));
+    else if (timestamp < buckets.last().start)
+        return false;
+
+    RollupBucket &bucket = buckets.last();
+    bucket.min = qMin(bucket.min, value);
+    bucket.max = qMax(bucket.max, value);
+    bucket.sum += value;
+    ++bucket.count;
+    return true;
+}
+
+void SeriesRollup::rebuild(const SeriesColumns &series)
+{
+    clear();
+    for (qsizetype i = 0; i < series.size(); ++i) {
+        if (series.isValid(i))
+            add(series.timestamp(i), series.value(i));
+    }
+}
+
+void SeriesRollup::clear()
+{
+    m_daily.clear();
+    m_monthly.clear();
+}
+
+const QVector<RollupBucket> &SeriesRollup::buckets(RollupLevel level) const
+{
+    return level == RollupLevel::Monthly ? m_monthly : m_daily;
+}
+
+QVector<RollupBucket> SeriesRollup::range(RollupLevel level, qint64 from, qint64 to) const
+{
+    const QVector<RollupBucket> &all = buckets(level);
+    auto first = std::lower_bound(all.cbegin(), all.cend(), from, [](const RollupBucket &b, qint64 ts) {
+        return b.end <= ts;
+    });
+    auto last = std::upper_bound(first, all.cend(), to, [](qint64 ts, const RollupBucket &b) {
+        return ts < b.start;
+    });
+    return QVector<RollupBucket>(first, last);
+}
+
+RollupBucket SeriesRollup::bucketFor(RollupLevel level, qint64 timestamp)
+{
+    RollupBucket bucket;
+    const QDate date = QDateTime::fromMSecsSinceEpoch(timestamp).date();
+    switch (level) {
+    case RollupLevel::Raw:
+        bucket.start = timestamp;
+        bucket.end = timestamp + 1;
+        break;
+    case RollupLevel::Daily:
+        bucket.start = date.startOfDay().toMSecsSinceEpoch();
+        bucket.end = date.addDays(1).startOfDay().toMSecsSinceEpoch();
+        break;
+    case RollupLevel::Monthly: {
+        const QDate month(date.year(), date.month(), 1);
+        bucket.start = month.startOfDay().toMSecsSinceEpoch();
+        bucket.end = month.addMonths(1).startOfDay().toMSecsSinceEpoch();
+        break;
+    }
+    }
+    return bucket;
+}
+
+RollupLevel SeriesRollup::levelFor(qint64 from, qint64 to, int pixelWidth)
+{
+    const qint64 span = qMax<qint64>(0, to - from);
+    const qint64 width = qMax(1, pixelWidth);
+    if (span / MsPerHour <= width)
+        return RollupLevel::Raw;
+    if (span / MsPerDay <= width)
+        return RollupLevel::Daily;
+    return RollupLevel::Monthly;
+}
+
+RollupQuery SeriesRollup::query(const SeriesColumns &series, qint64 from, qint64 to, RollupLevel level)
+{
+    RollupQuery result;
+    result.level = level;
+    const SeriesSlice slice = series.slice(from, to);
+    for (qsizetype i = slice.begin; i < slice.end; ++i) {
+        if (slice.columns.isValid(i))
+            addTo(result.buckets, level, slice.columns.timestamp(i), slice.columns.value(i));
+    }
+    return result;
+}
@@ -0,0 +1,84 @@
+#ifndef SERIESROLLUP_H
+#define SERIESROLLUP_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <limits>
+
+class SeriesColumns;
+
+/**
+ * @brief Poziom szczegółowości danych serii.
+ */
+enum class RollupLevel {
+    Raw = 0,    ///< Pomiary godzinowe z magazynu.
+    Daily,      ///< Agregaty dobowe (czas lokalny).
+    Monthly     ///< Agregaty miesięczne (czas lokalny).
+};
+
+/**
+ * @brief Agregat pomiarów z przedziału czasu [start, end).
+ */
+struct RollupBucket
+{
+    qint64 start = 0;                                   ///< Początek przedziału (ms od epoki).
+    qint64 end = 0;                                     ///< Koniec przedziału, wyłącznie.
+    float min = std::numeric_limits<float>::infinity(); ///< Minimum w przedziale.
+    float max = -std::numeric_limits<float>::infinity();///< Maksimum w przedziale.
+    double sum = 0.0;                                   ///< Suma wartości.
+    qint32 count = 0;                                   ///< Liczba ważnych pomiarów.
+
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+};
+
+/**
+ * @brief Wynik zapytania o zakres serii: wybrany poziom i przedziały z zakresu.
+ */
+struct RollupQuery
+{
+    RollupLevel level = RollupLevel::Raw;
+    QVector<RollupBucket> buckets;
+};
+
+/**
+ * @brief Piramida agregatów dobowych i miesięcznych jednej serii.
+ * @details Agregaty są aktualizowane przyrostowo przy dopisywaniu pomiarów w kolejności czasu;
+ * granice dób i miesięcy liczone są tylko przy przejściu do nowego przedziału.
+ * Pomiary starsze niż ostatni przedział wymagają przebudowy (rebuild).
+ */
+class SeriesRollup
+{
+public:
+    /**
+     * @brief Dopisuje ważny pomiar.
+     * @return false, gdy pomiar jest starszy niż ostatni przedział i piramidę trzeba przebudować.
+     */
+    bool add(qint64 timestamp, float value);
+    void rebuild(const SeriesColumns &series);
+    void clear();
+
+    const QVector<RollupBucket> &buckets(RollupLevel level) const;
+    QVector<RollupBucket> range(RollupLevel level, qint64 from, qint64 to) const;
+
+    static RollupBucket bucketFor(RollupLevel level, qint64 timestamp);
+    /**
+     * @brief Wybiera najgrubszy poziom, przy którym zakres nie traci rozdzielczości.
+     * @details Przy zakresie mieszczącym się w szerokości wykresu zwracane są pomiary godzinowe,
+     * dalej agregaty dobowe, a dla najdłuższych zakresów miesięczne.
+     * @param pixelWidth Szerokość obszaru rysowania w pikselach.
+     */
+    static RollupLevel levelFor(qint64 from, qint64 to, int pixelWidth);
+    /**
+     * @brief Agreguje zakres [from, to] serii na zadanym poziomie, bez utrzymywania piramidy.
+     * @details Na poziomie Raw każdy ważny pomiar jest osobnym przedziałem.
+     */
+    static RollupQuery query(const SeriesColumns &series, qint64 from, qint64 to, RollupLevel level);
+
+private:
+    static bool addTo(QVector<RollupBucket> &buckets, RollupLevel level, qint64 timestamp, float value);
+
+    QVector<RollupBucket> m_daily;
+    QVector<RollupBucket> m_monthly;
+};
+
+#endif // SERIESROLLUP_H
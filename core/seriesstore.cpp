@@ -0,0 +1,257 @@
+#include "seriesstore.h"
+#include "seriesanalysis.h"
+#include "dateparser.h"
+#include "tracer.h"
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+#include <numeric>
+
+void SeriesColumns::reserve(qsizetype size)
+{
+    m_timestamps.reserve(size);
+    m_values.reserve(size);
+    m_validBits.reserve((size + 63) / 64);
+}
+
+void SeriesColumns::append(qint64 timestamp, float value, bool valid)
+{
+    const qsizetype i = m_timestamps.size();
+    if ((i & 63) == 0)
+        m_validBits.append(0);
+    if (valid)
+        m_validBits[i >> 6] |= quint64(1) << (i & 63);
+
+    m_timestamps.append(timestamp);
+    m_values.append(valid ? value : 0.0f);
+}
+
+void SeriesColumns::set(qsizetype i, float value, bool valid)
+{
+    const quint64 bit = quint64(1) << (i & 63);
+    if (valid)
+        m_validBits[i >> 6] |= bit;
+    else
+        m_validBits[i >> 6] &= ~bit;
+    m_values[i] = valid ? value : 0.0f;
+}
+
+qsizetype SeriesColumns::lowerBound(qint64 timestamp) const
+{
+    return std::lower_bound(m_timestamps.cbegin(), m_timestamps.cend(), timestamp) - m_timestamps.cbegin();
+}
+
+qsizetype SeriesColumns::upperBound(qint64 timestamp) const
+{
+    return std::upper_bound(m_timestamps.cbegin(), m_timestamps.cend(), timestamp) - m_timestamps.cbegin();
+}
+
+SeriesSlice SeriesColumns::slice(qint64 from, qint64 to) const
+{
+    const qsizetype begin = lowerBound(from);
+    return SeriesSlice{*this, begin, qMax(begin, upperBound(to))};
+}
+
+void SeriesColumns::clear()
+{
+    m_timestamps.clear();
+    m_values.clear();
+    m_validBits.clear();
+}
+
+SeriesStore::MergeResult SeriesStore::ingest(int stationId, const MeasurementSeries &series)
+{
+    return merge(SeriesKey{stationId, series.paramCode}, columnsFromPoints(series.values));
+}
+
+SeriesStore::MergeResult SeriesStore::merge(const SeriesKey &key, const SeriesColumns &update)
+{
+    TraceSpan span("store merge", "store");
+    MergeResult result;
+    auto it = m_series.find(key);
+    if (it == m_series.end()) {
+        insert(key, update);
+        result.appended = update.size();
+        return result;
+    }
+
+    Entry &entry = it.value();
+    SeriesColumns &columns = entry.columns;
+    QVector<qsizetype> inserts;   // pomiary z luk w środku serii
+
+    for (qsizetype i = 0; i < update.size(); ++i) {
+        const qint64 ts = update.timestamp(i);
+        const float value = update.value(i);
+        const bool valid = update.isValid(i);
+
+        if (columns.isEmpty() || ts > columns.timestamp(columns.size() - 1)) {
+            columns.append(ts, value, valid);
+            if (valid) {
+                entry.aggregate.add(ts, value);
+                entry.rollup.add(ts, value);
+            }
+            ++result.appended;
+            continue;
+        }
+
+        const qsizetype pos = columns.lowerBound(ts);
+        if (pos < columns.size() && columns.timestamp(pos) == ts) {
+            // Brak odczytu nie kasuje wcześniej zapisanej wartości
+            if (!valid || (columns.isValid(pos) && columns.value(pos) == value))
+                continue;
+            columns.set(pos, value, true);
+            ++result.corrected;
+        } else {
+            inserts.append(i);
+        }
+    }
+
+    if (!inserts.isEmpty()) {
+        SeriesColumns rebuilt;
+        rebuilt.reserve(columns.size() + inserts.size());
+        qsizetype j = 0;
+        for (qsizetype i : inserts) {
+            const qint64 ts = update.timestamp(i);
+            for (; j < columns.size() && columns.timestamp(j) < ts; ++j)
+                rebuilt.append(columns.timestamp(j), columns.value(j), columns.isValid(j));
+            rebuilt.append(ts, update.value(i), update.isValid(i));
+        }
+        for (; j < columns.size(); ++j)
+            rebuilt.append(columns.timestamp(j), columns.value(j), columns.isValid(j));
+        columns = rebuilt;
+        result.corrected += inserts.size();
+    }
+
+    if (result.corrected > 0) {
+        entry.aggregate = RunningAggregate::fromColumns(columns, thresholdFor(key.paramCode));
+        entry.rollup.rebuild(columns);
+        emit seriesReset(key);
+    } else if (result.appended > 0) {
+        emit seriesAppended(key, result.appended);
+    }
+    return result;
+}
+
+void SeriesStore::insert(const SeriesKey &key, const SeriesColumns &columns)
+{
+    Entry entry{columns, RunningAggregate::fromColumns(columns, thresholdFor(key.paramCode)), SeriesRollup()};
+    entry.rollup.rebuild(columns);
+    m_series.insert(key, entry);
+    emit seriesReset(key);
+}
+
+RunningAggregate SeriesStore::aggregate(const SeriesKey &key) const
+{
+    auto it = m_series.constFind(key);
+    return it != m_series.cend() ? it->aggregate : RunningAggregate(thresholdFor(key.paramCode));
+}
+
+RollupQuery SeriesStore::query(const SeriesKey &key, qint64 from, qint64 to, int pixelWidth) const
+{
+    return query(key, from, to, SeriesRollup::levelFor(from, to, pixelWidth));
+}
+
+RollupQuery SeriesStore::query(const SeriesKey &key, qint64 from, qint64 to, RollupLevel level) const
+{
+    RollupQuery result;
+    result.level = level;
+    auto it = m_series.constFind(key);
+    if (it == m_series.cend())
+        return result;
+
+    if (result.level != RollupLevel::Raw) {
+        result.buckets = it->rollup.range(result.level, from, to);
+        return result;
+    }
+
+    // Poziom surowy nie ma piramidy - przedziały powstają wprost z kolumn
+    return SeriesRollup::query(it->columns, from, to, result.level);
+}
+
+QStringList SeriesStore::params(int stationId) const
+{
+    QStringList result;
+    for (auto it = m_series.cbegin(); it != m_series.cend(); ++it) {
+        if (it.key().stationId == stationId)
+            result << it.key().paramCode;
+    }
+    result.sort();
+    return result;
+}
+
+void SeriesStore::removeStation(int stationId)
+{
+    QList<SeriesKey> removed;
+    m_series.removeIf([stationId, &removed](QHash<SeriesKey, Entry>::iterator it) {
+        if (it.key().stationId != stationId)
+            return false;
+        removed << it.key();
+        return true;
+    });
+    for (const SeriesKey &key : std::as_const(removed))
+        emit seriesReset(key);
+}
+
+void SeriesStore::clear()
+{
+    const QList<SeriesKey> removed = m_series.keys();
+    m_series.clear();
+    for (const SeriesKey &key : removed)
+        emit seriesReset(key);
+}
+
+float SeriesStore::thresholdFor(const QString &paramCode)
+{
+    double threshold = 0.0;
+    if (SeriesAnalysis::exceedanceThreshold(paramCode, &threshold))
+        return static_cast<float>(threshold);
+    return std::numeric_limits<float>::infinity();
+}
+
+SeriesColumns SeriesStore::columnsFromPoints(const QList<MeasurementPoint> &points)
+{
+    // API zwraca pomiary od najnowszego; w magazynie trzymamy je rosnąco po czasie
+    // Daty są dekodowane raz, tutaj; dalej wszystkie zapytania operują na liczbach
+    DateParser parser;
+    QVector<qint64> timestamps;
+    timestamps.reserve(points.size());
+    int unreadable = 0;
+    for (const MeasurementPoint &point : points) {
+        qint64 ms = 0;
+        if (!parser.parse(point.date, &ms)) {
+            // Inne warianty ISO 8601 (sama data, strefa czasowa) - wolniejsza ścieżka QDateTime
+            const QDateTime dt = QDateTime::fromString(point.date, Qt::ISODate);
+            if (dt.isValid())
+                ms = dt.toMSecsSinceEpoch();
+            else
+                ++unreadable;
+        }
+        timestamps.append(ms);
+    }
+    if (unreadable > 0)
+        qDebug() << "Pominięto pomiary z nieczytelną datą:" << unreadable;
+
+    QVector<qsizetype> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](qsizetype a, qsizetype b) {
+        return timestamps[a] < timestamps[b];
+    });
+
+    SeriesColumns columns;
+    columns.reserve(points.size());
+    for (qsizetype i : order) {
+        if (timestamps[i] == 0)
+            continue;   // pomijamy pomiary z nieczytelną datą
+        const MeasurementPoint &point = points[i];
+        // Powtórzona godzina (duplikat w odpowiedzi, cofnięcie zegara) zostaje jednym pomiarem:
+        // wygrywa ostatni ważny odczyt, więc agregaty i eksport nie liczą jej dwa razy
+        const qsizetype last = columns.size() - 1;
+        if (last >= 0 && columns.timestamp(last) == timestamps[i]) {
+            if (point.valid)
+                columns.set(last, static_cast<float>(point.value), true);
+            continue;
+        }
+        columns.append(timestamps[i], static_cast<float>(point.value), point.valid);
+    }
+    return columns;
+}
@@ -0,0 +1,176 @@
+#ifndef SERIESSTORE_H
+#define SERIESSTORE_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include "giosdata.h"
+#include "runningaggregate.h"
+#include "seriesrollup.h"
+
+/**
+ * @brief Klucz serii pomiarowej: stacja i kod parametru.
+ */
+struct SeriesKey
+{
+    int stationId = 0;      ///< ID stacji.
+    QString paramCode;      ///< Kod parametru, np. "PM10".
+};
+
+inline bool operator==(const SeriesKey &a, const SeriesKey &b)
+{
+    return a.stationId == b.stationId && a.paramCode == b.paramCode;
+}
+
+inline size_t qHash(const SeriesKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.stationId, key.paramCode);
+}
+
+struct SeriesSlice;
+
+/**
+ * @brief Kolumnowa seria czasowa.
+ * @details Znaczniki czasu (ms od epoki) i wartości leżą w osobnych, ciągłych tablicach,
+ * posortowanych rosnąco po czasie. Brakujące odczyty (null z API) oznacza bitmapa ważności.
+ * Kopiowanie jest tanie dzięki współdzieleniu danych przez QVector.
+ */
+class SeriesColumns
+{
+public:
+    void reserve(qsizetype size);
+    void append(qint64 timestamp, float value, bool valid);
+    void set(qsizetype i, float value, bool valid);
+    void clear();
+
+    qsizetype size() const { return m_timestamps.size(); }
+    bool isEmpty() const { return m_timestamps.isEmpty(); }
+
+    qint64 timestamp(qsizetype i) const { return m_timestamps[i]; }
+    float value(qsizetype i) const { return m_values[i]; }
+    bool isValid(qsizetype i) const { return (m_validBits[i >> 6] >> (i & 63)) & 1; }
+
+    const qint64 *timestamps() const { return m_timestamps.constData(); }
+    const float *values() const { return m_values.constData(); }
+    const quint64 *validity() const { return m_validBits.constData(); }
+
+    qsizetype lowerBound(qint64 timestamp) const;
+    qsizetype upperBound(qint64 timestamp) const;
+    /**
+     * @brief Zwraca pomiary z zakresu [from, to] wyszukane binarnie, w czasie O(log n), bez kopiowania.
+     */
+    SeriesSlice slice(qint64 from, qint64 to) const;
+
+private:
+    QVector<qint64> m_timestamps;   ///< Czas pomiaru w ms od epoki.
+    QVector<float> m_values;        ///< Wartości (0 dla brakujących odczytów).
+    QVector<quint64> m_validBits;   ///< Bit i ustawiony, gdy pomiar i jest ważny.
+};
+
+/**
+ * @brief Zakres [begin, end) serii kolumnowej.
+ * @details Trzyma współdzieloną kopię kolumn, więc pozostaje ważny niezależnie od magazynu,
+ * a jego utworzenie nie kopiuje danych.
+ */
+struct SeriesSlice
+{
+    SeriesColumns columns;
+    qsizetype begin = 0;
+    qsizetype end = 0;
+
+    qsizetype size() const { return end - begin; }
+    bool isEmpty() const { return begin == end; }
+};
+
+/**
+ * @brief Źródło zakresów serii, np. odczyt z archiwum.
+ * @details Źródła wywoływane w puli wątków (raporty, eksport) muszą być bezpieczne wątkowo.
+ */
+using SeriesSource = std::function<SeriesColumns(const SeriesKey &key, qint64 from, qint64 to)>;
+
+/**
+ * @brief Magazyn serii pomiarowych w pamięci, indeksowany parą (stacja, parametr).
+ * @details Dla każdej serii utrzymywany jest łączalny agregat (RunningAggregate) oraz piramida
+ * agregatów dobowych i miesięcznych (SeriesRollup), aktualizowane przy dopisywaniu nowych pomiarów,
+ * dzięki czemu statystyki i długie zakresy są dostępne bez skanowania kolumn.
+ * Zmiany są zgłaszane sygnałami, więc otwarte wykresy mogą dopisywać tylko nowe punkty.
+ */
+class SeriesStore : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SeriesStore(QObject *parent = nullptr) : QObject(parent) {}
+
+    /**
+     * @brief Wynik scalenia nowej odpowiedzi z serią w magazynie.
+     */
+    struct MergeResult
+    {
+        qsizetype appended = 0;     ///< Liczba pomiarów dopisanych na końcu serii.
+        qsizetype corrected = 0;    ///< Liczba poprawionych lub wstawionych wcześniejszych pomiarów.
+    };
+
+    /**
+     * @brief Scala serię z API z danymi już zgromadzonymi dla pary (stacja, parametr).
+     * @param stationId ID stacji.
+     * @param series Seria zdekodowana z odpowiedzi data/getData.
+     */
+    MergeResult ingest(int stationId, const MeasurementSeries &series);
+    /**
+     * @brief Scala kolumny z istniejącą serią.
+     * @details Pomiary nowsze niż ostatni zapisany są dopisywane, a agregat aktualizowany w O(1)
+     * na pomiar. Korekty starszych pomiarów nadpisują wartości i wymuszają jednorazowe
+     * przeliczenie agregatu jądrem wektorowym.
+     */
+    MergeResult merge(const SeriesKey &key, const SeriesColumns &update);
+    void insert(const SeriesKey &key, const SeriesColumns &columns);
+
+    bool contains(const SeriesKey &key) const { return m_series.contains(key); }
+    QList<SeriesKey> keys() const { return m_series.keys(); }
+    SeriesColumns series(const SeriesKey &key) const { return m_series.value(key).columns; }
+    RunningAggregate aggregate(const SeriesKey &key) const;
+    /**
+     * @brief Zwraca zakres serii na poziomie dobranym do długości zakresu i szerokości wykresu.
+     * @param from Początek zakresu (ms od epoki).
+     * @param to Koniec zakresu, włącznie.
+     * @param pixelWidth Szerokość obszaru rysowania w pikselach.
+     */
+    RollupQuery query(const SeriesKey &key, qint64 from, qint64 to, int pixelWidth) const;
+    RollupQuery query(const SeriesKey &key, qint64 from, qint64 to, RollupLevel level) const;
+    QStringList params(int stationId) const;
+
+    void removeStation(int stationId);
+    void clear();
+
+    /**
+     * @brief Zamienia pomiary z API na kolumny posortowane po czasie, bez powtórzonych znaczników czasu.
+     */
+    static SeriesColumns columnsFromPoints(const QList<MeasurementPoint> &points);
+
+signals:
+    /**
+     * @brief Na końcu serii dopisano nowe pomiary; wcześniejsze dane się nie zmieniły.
+     * @param count Liczba dopisanych pomiarów.
+     */
+    void seriesAppended(const SeriesKey &key, qsizetype count);
+    /**
+     * @brief Seria została zastąpiona, poprawiona lub usunięta i trzeba ją odczytać od nowa.
+     */
+    void seriesReset(const SeriesKey &key);
+
+private:
+    struct Entry
+    {
+        SeriesColumns columns;
+        RunningAggregate aggregate = RunningAggregate();
+        SeriesRollup rollup;
+    };
+
+    static float thresholdFor(const QString &paramCode);
+
+    QHash<SeriesKey, Entry> m_series;
+};
+
+#endif // SERIESSTORE_H
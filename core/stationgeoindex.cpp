@@ -0,0 +1,189 @@
+#include "stationgeoindex.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double EarthRadiusKm = 6371.0088;
+constexpr int StationsPerCell = 4;
+
+} // namespace
+
+double StationGeoIndex::distanceKm(double lat1, double lon1, double lat2, double lon2)
+{
+    const double dLat = qDegreesToRadians(lat2 - lat1);
+    const double dLon = qDegreesToRadians(lon2 - lon1);
+    const double a = std::sin(dLat / 2) * std::sin(dLat / 2)
+                     + std::cos(qDegreesToRadians(lat1)) * std::cos(qDegreesToRadians(lat2))
+                           * std::sin(dLon / 2) * std::sin(dLon / 2);
+    return 2.0 * EarthRadiusKm * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+void StationGeoIndex::build(const QList<Station> &stations)
+{
+    clear();
+    m_lat.resize(stations.size());
+    m_lon.resize(stations.size());
+
+    double maxLat = -90.0;
+    double maxLon = -180.0;
+    m_minLat = 90.0;
+    m_minLon = 180.0;
+    int located = 0;
+    for (int row = 0; row < stations.size(); ++row) {
+        const Station &station = stations[row];
+        m_lat[row] = station.latitude;
+        m_lon[row] = station.longitude;
+        if (!station.hasLocation())
+            continue;
+        ++located;
+        m_minLat = qMin(m_minLat, station.latitude);
+        m_minLon = qMin(m_minLon, station.longitude);
+        maxLat = qMax(maxLat, station.latitude);
+        maxLon = qMax(maxLon, station.longitude);
+    }
+    if (located == 0)
+        return;
+
+    // Komórka kwadratowa w stopniach, o polu odpowiadającym kilku stacjom
+    const double area = qMax(1e-6, (maxLat - m_minLat) * (maxLon - m_minLon));
+    m_cellDeg = qMax(0.01, std::sqrt(area * StationsPerCell / located));
+    m_rowsCount = int((maxLat - m_minLat) / m_cellDeg) + 1;
+    m_colsCount = int((maxLon - m_minLon) / m_cellDeg) + 1;
+
+    // Sortowanie przez zliczanie: najpierw liczności komórek, potem rozmieszczenie wierszy
+    QVector<int> cellOf(stations.size(), -1);
+    m_cellStart.fill(0, m_rowsCount * m_colsCount + 1);
+    for (int row = 0; row < stations.size(); ++row) {
+        if (!stations[row].hasLocation())
+            continue;
+        cellOf[row] = cellRow(m_lat[row]) * m_colsCount + cellColumn(m_lon[row]);
+        ++m_cellStart[cellOf[row] + 1];
+    }
+    for (int i = 1; i < m_cellStart.size(); ++i)
+        m_cellStart[i] += m_cellStart[i - 1];
+
+    m_rows.resize(located);
+    QVector<int> fill = m_cellStart;
+    for (int row = 0; row < stations.size(); ++row) {
+        if (cellOf[row] >= 0)
+            m_rows[fill[cellOf[row]]++] = row;
+    }
+}
+
+void StationGeoIndex::clear()
+{
+    m_rowsCount = 0;
+    m_colsCount = 0;
+    m_cellStart.clear();
+    m_rows.clear();
+    m_lat.clear();
+    m_lon.clear();
+}
+
+int StationGeoIndex::cellRow(double latitude) const
+{
+    return qBound(0, int(std::floor((latitude - m_minLat) / m_cellDeg)), m_rowsCount - 1);
+}
+
+int StationGeoIndex::cellColumn(double longitude) const
+{
+    return qBound(0, int(std::floor((longitude - m_minLon) / m_cellDeg)), m_colsCount - 1);
+}
+
+template<typename Visitor>
+void StationGeoIndex::visitCells(int row0, int col0, int row1, int col1, Visitor visit) const
+{
+    for (int r = qMax(0, row0); r <= qMin(row1, m_rowsCount - 1); ++r) {
+        for (int c = qMax(0, col0); c <= qMin(col1, m_colsCount - 1); ++c) {
+            const int cell = r * m_colsCount + c;
+            for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i)
+                visit(m_rows[i]);
+        }
+    }
+}
+
+QVector<StationGeoIndex::Hit> StationGeoIndex::nearest(double latitude, double longitude, int count) const
+{
+    if (isEmpty() || count <= 0)
+        return {};
+    if (count >= m_rows.size())
+        return within(latitude, longitude, std::numeric_limits<double>::infinity());
+
+    // Rozszerzamy pierścienie komórek wokół punktu, aż zbierzemy count kandydatów
+    const int cr = cellRow(latitude);
+    const int cc = cellColumn(longitude);
+    QVector<double> distances;
+    const auto collect = [&](int row) {
+        distances.append(distanceKm(latitude, longitude, m_lat[row], m_lon[row]));
+    };
+    for (int k = 0; distances.size() < count; ++k) {
+        visitCells(cr - k, cc - k, cr - k, cc + k, collect);
+        if (k > 0) {
+            visitCells(cr + k, cc - k, cr + k, cc + k, collect);
+            visitCells(cr - k + 1, cc - k, cr + k - 1, cc - k, collect);
+            visitCells(cr - k + 1, cc + k, cr + k - 1, cc + k, collect);
+        }
+    }
+
+    // Kandydaci z pierścieni nie muszą być najbliżsi - count-ta odległość wyznacza
+    // promień, w którym na pewno leży count najbliższych stacji
+    std::nth_element(distances.begin(), distances.begin() + (count - 1), distances.end());
+    QVector<Hit> hits = within(latitude, longitude, distances[count - 1]);
+    hits.resize(qMin<qsizetype>(hits.size(), count));
+    return hits;
+}
+
+QVector<StationGeoIndex::Hit> StationGeoIndex::within(double latitude, double longitude, double radiusKm) const
+{
+    QVector<Hit> hits;
+    if (isEmpty() || radiusKm < 0.0)
+        return hits;
+
+    // Prostokąt ograniczający okrąg na kuli
+    int row0 = 0;
+    int row1 = m_rowsCount - 1;
+    int col0 = 0;
+    int col1 = m_colsCount - 1;
+    const double angular = radiusKm / EarthRadiusKm;
+    if (angular < M_PI) {
+        const double dLat = qRadiansToDegrees(angular);
+        row0 = cellRow(latitude - dLat);
+        row1 = cellRow(latitude + dLat);
+        const double cosLat = std::cos(qDegreesToRadians(latitude));
+        if (latitude + dLat < 90.0 && latitude - dLat > -90.0 && std::sin(angular) < cosLat) {
+            const double dLon = qRadiansToDegrees(std::asin(std::sin(angular) / cosLat));
+            col0 = cellColumn(longitude - dLon);
+            col1 = cellColumn(longitude + dLon);
+        }
+    }
+
+    visitCells(row0, col0, row1, col1, [&](int row) {
+        const double d = distanceKm(latitude, longitude, m_lat[row], m_lon[row]);
+        if (d <= radiusKm)
+            hits.append(Hit{row, d});
+    });
+    std::sort(hits.begin(), hits.end(), [](const Hit &a, const Hit &b) {
+        return a.distanceKm < b.distanceKm || (a.distanceKm == b.distanceKm && a.row < b.row);
+    });
+    return hits;
+}
+
+QVector<int> StationGeoIndex::inBox(double minLatitude, double minLongitude,
+                                    double maxLatitude, double maxLongitude) const
+{
+    QVector<int> rows;
+    if (isEmpty())
+        return rows;
+
+    visitCells(cellRow(minLatitude), cellColumn(minLongitude), cellRow(maxLatitude), cellColumn(maxLongitude),
+               [&](int row) {
+        if (m_lat[row] >= minLatitude && m_lat[row] <= maxLatitude
+            && m_lon[row] >= minLongitude && m_lon[row] <= maxLongitude)
+            rows.append(row);
+    });
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
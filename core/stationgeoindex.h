@@ -0,0 +1,64 @@
+#ifndef STATIONGEOINDEX_H
+#define STATIONGEOINDEX_H
+
+#include <QList>
+#include <QVector>
+#include "giosdata.h"
+
+/**
+ * @brief Indeks przestrzenny stacji: jednorodna siatka w stopniach szerokości i długości.
+ * @details Siatka obejmuje prostokąt ograniczający wszystkie stacje ze współrzędnymi,
+ * a rozmiar komórki jest dobrany tak, by na komórkę przypadało średnio kilka stacji.
+ * Komórki są zapisane w jednej tablicy (offsety + numery wierszy), bez alokacji na komórkę.
+ * Zapytania przeglądają tylko komórki mogące zawierać wynik; odległości liczone są
+ * wzorem haversine'a po kuli o promieniu 6371 km. Stacje bez współrzędnych są pomijane.
+ */
+class StationGeoIndex
+{
+public:
+    /**
+     * @brief Stacja znaleziona przez zapytanie.
+     */
+    struct Hit
+    {
+        int row;            ///< Pozycja stacji w liście przekazanej do build.
+        double distanceKm;  ///< Odległość od punktu zapytania (0 dla zapytań prostokątem).
+    };
+
+    void build(const QList<Station> &stations);
+    void clear();
+    bool isEmpty() const { return m_rows.isEmpty(); }
+
+    /**
+     * @brief Zwraca count najbliższych stacji, posortowanych rosnąco po odległości.
+     */
+    QVector<Hit> nearest(double latitude, double longitude, int count) const;
+    /**
+     * @brief Zwraca stacje w promieniu radiusKm, posortowane rosnąco po odległości.
+     */
+    QVector<Hit> within(double latitude, double longitude, double radiusKm) const;
+    /**
+     * @brief Zwraca rosnące numery wierszy stacji leżących w prostokącie (włącznie z brzegami).
+     */
+    QVector<int> inBox(double minLatitude, double minLongitude, double maxLatitude, double maxLongitude) const;
+
+    static double distanceKm(double lat1, double lon1, double lat2, double lon2);
+
+private:
+    int cellRow(double latitude) const;
+    int cellColumn(double longitude) const;
+    template<typename Visitor>
+    void visitCells(int row0, int col0, int row1, int col1, Visitor visit) const;
+
+    double m_minLat = 0.0;
+    double m_minLon = 0.0;
+    double m_cellDeg = 1.0;             ///< Bok komórki w stopniach.
+    int m_rowsCount = 0;
+    int m_colsCount = 0;
+    QVector<int> m_cellStart;           ///< Początek listy komórki w m_rows (rozmiar komórek + 1).
+    QVector<int> m_rows;                ///< Numery wierszy stacji pogrupowane po komórkach.
+    QVector<double> m_lat;              ///< Szerokość według numeru wiersza.
+    QVector<double> m_lon;              ///< Długość według numeru wiersza.
+};
+
+#endif // STATIONGEOINDEX_H
@@ -0,0 +1,159 @@
+#include "stationmodel.h"
+#include "tracer.h"
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+StationListModel::StationListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+StationListModel::Catalogue StationListModel::Catalogue::build(const QList<Station> &stations)
+{
+    Catalogue catalogue;
+    catalogue.stations = stations;
+    catalogue.rowById.reserve(stations.size());
+    for (int row = 0; row < stations.size(); ++row)
+        catalogue.rowById.insert(stations[row].id, row);
+    catalogue.index.build(stations);
+    catalogue.geoIndex.build(stations);
+    return catalogue;
+}
+
+void StationListModel::setStations(const QList<Station> &stations, quint64 contentHash)
+{
+    TraceSpan span("station list", "render");
+    Catalogue catalogue = Catalogue::build(stations);
+    beginResetModel();
+    m_snapshot.reset();
+    m_indexed = true;
+    m_contentHash = contentHash;
+    adopt(std::move(catalogue));
+    endResetModel();
+}
+
+void StationListModel::setSnapshot(std::shared_ptr<const StationSnapshot> snapshot)
+{
+    TraceSpan span("station snapshot", "render");
+    beginResetModel();
+    m_snapshot = snapshot;
+    m_indexed = false;
+    m_contentHash = snapshot->contentHash();
+    adopt(Catalogue());
+    endResetModel();
+
+    // Wiersze są już widoczne; pełną listę i indeksy budujemy w tle
+    auto *watcher = new QFutureWatcher<Catalogue>(this);
+    connect(watcher, &QFutureWatcher<Catalogue>::finished, this, [this, watcher, snapshot]() {
+        watcher->deleteLater();
+        // Katalog mógł zostać w międzyczasie zastąpiony świeżo pobranym
+        if (m_snapshot != snapshot || m_indexed)
+            return;
+        adopt(watcher->result());
+        m_indexed = true;
+        // Wiersze są już w pamięci; zwolnienie mapowania pozwala podmienić plik migawki (Windows)
+        m_snapshot.reset();
+        emit indexed();
+    });
+    watcher->setFuture(QtConcurrent::run([snapshot]() {
+        TraceSpan indexSpan("station index", "parse");
+        return Catalogue::build(snapshot->stations());
+    }));
+}
+
+void StationListModel::adopt(Catalogue &&catalogue)
+{
+    m_stations = std::move(catalogue.stations);
+    m_rowById = std::move(catalogue.rowById);
+    m_index = std::move(catalogue.index);
+    m_geoIndex = std::move(catalogue.geoIndex);
+}
+
+std::optional<Station> StationListModel::stationById(int id) const
+{
+    if (m_indexed) {
+        auto it = m_rowById.constFind(id);
+        if (it == m_rowById.cend())
+            return std::nullopt;
+        return m_stations[it.value()];
+    }
+    const int row = m_snapshot->rowOf(id);
+    if (row < 0)
+        return std::nullopt;
+    return m_snapshot->station(row);
+}
+
+int StationListModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_indexed ? int(m_stations.size()) : m_snapshot->size();
+}
+
+QVariant StationListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+
+    // Przed zbudowaniem indeksów widok czyta tylko widoczne wiersze, dekodowane z migawki
+    Station decoded;
+    const Station &station = m_indexed ? m_stations[index.row()] : (decoded = m_snapshot->station(index.row()));
+    switch (role) {
+    case Qt::DisplayRole:
+        return station.name;
+    case Qt::ToolTipRole:
+        return QString("%1, %2").arg(station.cityName, station.provinceName);
+    case IdRole:
+        return station.id;
+    case CityRole:
+        return station.cityName;
+    case ProvinceRole:
+        return station.provinceName;
+    default:
+        return QVariant();
+    }
+}
+
+StationFilterProxy::StationFilterProxy(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+    connect(this, &QSortFilterProxyModel::sourceModelChanged, this, &StationFilterProxy::refreshMatches);
+}
+
+void StationFilterProxy::setSearchText(const QString &text)
+{
+    if (text == m_text)
+        return;
+    m_text = text;
+    refreshMatches();
+}
+
+void StationFilterProxy::refreshMatches()
+{
+    auto *model = qobject_cast<StationListModel *>(sourceModel());
+    if (!model) {
+        m_matches.clear();
+        invalidateFilter();
+        return;
+    }
+
+    // Po wymianie katalogu stacji (setStations) wynik zapytania trzeba policzyć od nowa
+    connect(model, &QAbstractItemModel::modelReset, this, &StationFilterProxy::refreshMatches, Qt::UniqueConnection);
+    connect(model, &StationListModel::indexed, this, &StationFilterProxy::refreshMatches, Qt::UniqueConnection);
+    if (!model->isIndexed()) {
+        // Indeks katalogu z migawki jeszcze powstaje; pokazujemy całą listę
+        m_matches.fill(true, model->rowCount());
+        invalidateFilter();
+        return;
+    }
+    m_matches.fill(false, model->rowCount());
+    for (int row : model->searchIndex().search(m_text))
+        m_matches[row] = true;
+    invalidateFilter();
+}
+
+bool StationFilterProxy::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    Q_UNUSED(sourceParent);
+    return sourceRow < m_matches.size() && m_matches[sourceRow];
+}
@@ -0,0 +1,110 @@
+#ifndef STATIONMODEL_H
+#define STATIONMODEL_H
+
+#include <QAbstractListModel>
+#include <QSortFilterProxyModel>
+#include <QHash>
+#include <QVector>
+#include <memory>
+#include <optional>
+#include "giosdata.h"
+#include "stationsnapshot.h"
+#include "stationsearch.h"
+#include "stationgeoindex.h"
+
+/**
+ * @brief Model listy stacji dla widoków Qt.
+ * @details Wiersze odpowiadają kolejnym stacjom z katalogu; widok pobiera tylko widoczne
+ * wiersze, więc pełny katalog nie tworzy tysięcy elementów interfejsu. Każdy wiersz
+ * udostępnia stabilne ID stacji w roli IdRole, niezależne od filtrowania i sortowania.
+ *
+ * Katalog z migawki (setSnapshot) jest widoczny od razu: wiersze są czytane wprost z mapowanego
+ * pliku, a dekodowanie całej listy i budowa indeksów wyszukiwania odbywa się w puli wątków.
+ * Do tego czasu filtr przepuszcza wszystkie wiersze, a indeksy są puste. Po zbudowaniu
+ * indeksów mapowanie jest zwalniane; model zachowuje tylko skrót zawartości migawki.
+ */
+class StationListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Role {
+        IdRole = Qt::UserRole + 1,  ///< ID stacji (int).
+        CityRole,                   ///< Nazwa miasta.
+        ProvinceRole                ///< Nazwa województwa.
+    };
+
+    explicit StationListModel(QObject *parent = nullptr);
+
+    /**
+     * @param contentHash Skrót zawartości katalogu (StationSnapshot::contentHash), 0 gdy nieznany.
+     */
+    void setStations(const QList<Station> &stations, quint64 contentHash = 0);
+    void setSnapshot(std::shared_ptr<const StationSnapshot> snapshot);
+    quint64 contentHash() const { return m_contentHash; }
+    bool isIndexed() const { return m_indexed; }
+
+    const QList<Station> &stations() const { return m_stations; }
+    const StationSearchIndex &searchIndex() const { return m_index; }
+    const StationGeoIndex &geoIndex() const { return m_geoIndex; }
+
+    /**
+     * @brief Zwraca stację o podanym ID, także przed zbudowaniem indeksów katalogu z migawki.
+     */
+    std::optional<Station> stationById(int id) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+signals:
+    /**
+     * @brief Lista stacji i indeksy katalogu z migawki są gotowe; wiersze się nie zmieniły.
+     */
+    void indexed();
+
+private:
+    struct Catalogue
+    {
+        QList<Station> stations;
+        QHash<int, int> rowById;
+        StationSearchIndex index;
+        StationGeoIndex geoIndex;
+
+        static Catalogue build(const QList<Station> &stations);
+    };
+
+    void adopt(Catalogue &&catalogue);
+
+    std::shared_ptr<const StationSnapshot> m_snapshot;  ///< Tylko do zbudowania indeksów.
+    bool m_indexed = true;          ///< false, dopóki wiersze pochodzą wprost z migawki.
+    quint64 m_contentHash = 0;      ///< Skrót zawartości wyświetlanego katalogu.
+    QList<Station> m_stations;
+    QHash<int, int> m_rowById;      ///< ID stacji → wiersz.
+    StationSearchIndex m_index;
+    StationGeoIndex m_geoIndex;
+};
+
+/**
+ * @brief Filtr listy stacji oparty na indeksie wyszukiwania.
+ * @details Zmiana tekstu wykonuje jedno zapytanie do indeksu i zapamiętuje wynik
+ * w postaci mapy bitowej, więc filterAcceptsRow jest odczytem jednego bitu.
+ */
+class StationFilterProxy : public QSortFilterProxyModel
+{
+    Q_OBJECT
+public:
+    explicit StationFilterProxy(QObject *parent = nullptr);
+
+    void setSearchText(const QString &text);
+    QString searchText() const { return m_text; }
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    void refreshMatches();
+
+    QString m_text;
+    QVector<bool> m_matches;    ///< Dla każdego wiersza źródła: czy pasuje do tekstu.
+};
+
+#endif // STATIONMODEL_H
@@ -0,0 +1,129 @@
+#include "stationsearch.h"
+#include <QRegularExpression>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace {
+
+QChar foldChar(QChar c)
+{
+    switch (c.unicode()) {
+    case u'ą': case u'Ą': return u'a';
+    case u'ć': case u'Ć': return u'c';
+    case u'ę': case u'Ę': return u'e';
+    case u'ł': case u'Ł': return u'l';
+    case u'ń': case u'Ń': return u'n';
+    case u'ó': case u'Ó': return u'o';
+    case u'ś': case u'Ś': return u's';
+    case u'ź': case u'Ź': case u'ż': case u'Ż': return u'z';
+    default: return c.toLower();
+    }
+}
+
+QStringList words(const QString &folded)
+{
+    static const QRegularExpression separators("[^\\w]+");
+    return folded.split(separators, Qt::SkipEmptyParts);
+}
+
+} // namespace
+
+QString StationSearchIndex::fold(QStringView text)
+{
+    QString result(text.size(), Qt::Uninitialized);
+    for (qsizetype i = 0; i < text.size(); ++i)
+        result[i] = foldChar(text[i]);
+    return result;
+}
+
+quint64 StationSearchIndex::trigram(const QChar *p)
+{
+    return (quint64(p[0].unicode()) << 32) | (quint64(p[1].unicode()) << 16) | p[2].unicode();
+}
+
+void StationSearchIndex::build(const QList<Station> &stations)
+{
+    clear();
+    m_texts.reserve(stations.size());
+
+    for (int row = 0; row < stations.size(); ++row) {
+        const Station &station = stations[row];
+        const QString text = fold(QStringList{station.cityName, station.name, station.communeName,
+                                              station.provinceName}.join(u' '));
+        m_texts.append(text);
+
+        for (const QString &word : words(text)) {
+            // Wiersze są dodawane rosnąco, więc wystarczy nie powtarzać ostatniego
+            for (qsizetype i = 0; i + 3 <= word.size(); ++i) {
+                QVector<int> &rows = m_trigrams[trigram(word.constData() + i)];
+                if (rows.isEmpty() || rows.last() != row)
+                    rows.append(row);
+            }
+        }
+    }
+}
+
+void StationSearchIndex::clear()
+{
+    m_texts.clear();
+    m_trigrams.clear();
+}
+
+QVector<int> StationSearchIndex::search(const QString &query) const
+{
+    const QStringList terms = words(fold(query));
+    if (terms.isEmpty()) {
+        QVector<int> all(m_texts.size());
+        std::iota(all.begin(), all.end(), 0);
+        return all;
+    }
+
+    QVector<int> result = searchWord(terms.first());
+    for (qsizetype i = 1; i < terms.size() && !result.isEmpty(); ++i) {
+        const QVector<int> next = searchWord(terms[i]);
+        QVector<int> both;
+        std::set_intersection(result.cbegin(), result.cend(), next.cbegin(), next.cend(), std::back_inserter(both));
+        result = both;
+    }
+    return result;
+}
+
+QVector<int> StationSearchIndex::searchWord(const QString &word) const
+{
+    QVector<int> rows;
+    if (word.size() < 3) {
+        // Za krótkie na trigramy - ta sama semantyka podciągu, sprawdzana wprost na tekstach
+        for (int row = 0; row < m_texts.size(); ++row) {
+            if (m_texts[row].contains(word))
+                rows.append(row);
+        }
+        return rows;
+    }
+
+    // Kandydaci: przecięcie list trigramów, zaczynając od najkrótszej
+    QVector<const QVector<int> *> lists;
+    for (qsizetype i = 0; i + 3 <= word.size(); ++i) {
+        auto it = m_trigrams.constFind(trigram(word.constData() + i));
+        if (it == m_trigrams.cend())
+            return rows;
+        lists.append(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->size() < b->size();
+    });
+
+    rows = *lists.first();
+    for (qsizetype i = 1; i < lists.size() && !rows.isEmpty(); ++i) {
+        QVector<int> both;
+        std::set_intersection(rows.cbegin(), rows.cend(), lists[i]->cbegin(), lists[i]->cend(),
+                              std::back_inserter(both));
+        rows = both;
+    }
+
+    // Trigramy mogą pochodzić z różnych miejsc tekstu - potwierdzamy pełnym dopasowaniem
+    rows.removeIf([this, &word](int row) {
+        return !m_texts[row].contains(word);
+    });
+    return rows;
+}
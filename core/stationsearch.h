@@ -0,0 +1,44 @@
+#ifndef STATIONSEARCH_H
+#define STATIONSEARCH_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVector>
+#include "giosdata.h"
+
+/**
+ * @brief Indeks wyszukiwania stacji po mieście, nazwie, gminie i województwie.
+ * @details Teksty są sprowadzane do małych liter bez polskich znaków diakrytycznych
+ * („Łódź” → „lodz”). Każde słowo zapytania jest dopasowywane jako podciąg, niezależnie
+ * od długości, więc dopisanie litery tylko zawęża wyniki. Słowa od 3 znaków korzystają
+ * z przecięcia list trigramów i weryfikacji kandydatów, krótsze sprawdzane są wprost
+ * na tekstach stacji (jest ich kilkaset). Zapytanie z kilku słów zwraca stacje pasujące
+ * do wszystkich słów. Indeks buduje się raz, po wczytaniu katalogu stacji.
+ */
+class StationSearchIndex
+{
+public:
+    void build(const QList<Station> &stations);
+    void clear();
+
+    /**
+     * @brief Zwraca posortowane numery wierszy (pozycje w liście przekazanej do build) pasujących stacji.
+     */
+    QVector<int> search(const QString &query) const;
+    qsizetype size() const { return m_texts.size(); }
+
+    /**
+     * @brief Zamienia tekst na małe litery bez polskich znaków diakrytycznych.
+     */
+    static QString fold(QStringView text);
+
+private:
+    QVector<int> searchWord(const QString &word) const;
+    static quint64 trigram(const QChar *p);
+
+    QVector<QString> m_texts;               ///< Złączone, znormalizowane pola każdej stacji.
+    QHash<quint64, QVector<int>> m_trigrams;///< Trigram → rosnąca lista wierszy.
+};
+
+#endif // STATIONSEARCH_H
@@ -0,0 +1,323 @@
+#include "stationsnapshot.h"
+#include "giosparser.h"
+#include "tracer.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+constexpr char Magic[4] = {'G', 'I', 'O', 'S'};
+constexpr quint16 FormatVersion = 1;
+
+struct IdEntry
+{
+    qint32 id;
+    qint32 row;
+};
+static_assert(sizeof(IdEntry) == 8, "IdEntry musi mieć 8 bajtów");
+
+/**
+ * @brief Rozmiar pliku wynikający z nagłówka; -1, gdy liczby są nierealne.
+ */
+qint64 expectedSize(const SnapshotHeader &header)
+{
+    if (header.stationCount > quint32(std::numeric_limits<int>::max())
+        || header.charCount > quint64(std::numeric_limits<qint64>::max() / 4))
+        return -1;
+    return qint64(sizeof(SnapshotHeader))
+           + qint64(header.stationCount) * qint64(sizeof(SnapshotRecord) + sizeof(IdEntry))
+           + (qint64(header.stringCount) + 1) * qint64(sizeof(quint32))
+           + qint64(header.charCount) * qint64(sizeof(char16_t));
+}
+
+/**
+ * @brief FNV-1a - skrót niezależny od ziarna QHash, więc stały między uruchomieniami.
+ */
+quint64 fnv1a(const char *data, qsizetype size)
+{
+    quint64 hash = 14695981039346656037ULL;
+    for (qsizetype i = 0; i < size; ++i) {
+        hash ^= uchar(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+StationSnapshot::StationSnapshot(const QString &path)
+    : m_file(path)
+{
+}
+
+StationSnapshot::~StationSnapshot()
+{
+    close();
+}
+
+bool StationSnapshot::open()
+{
+    TraceSpan span("snapshot open", "io");
+    close();
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 fileSize = m_file.size();
+    if (fileSize < qint64(sizeof(SnapshotHeader))) {
+        m_file.close();
+        return false;
+    }
+
+    m_map = m_file.map(0, fileSize);
+    if (!m_map) {
+        m_file.close();
+        return false;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, m_map, sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0
+        || header.version != FormatVersion
+        || header.recordSize != sizeof(SnapshotRecord)
+        || expectedSize(header) != fileSize) {
+        // Inna wersja formatu albo przerwany zapis: migawka zostanie odtworzona po pobraniu katalogu
+        qDebug() << "Nieprawidłowa migawka katalogu stacji:" << m_file.fileName();
+        close();
+        return false;
+    }
+
+    // Sprawdzane są tylko nagłówek i rozmiar; numery napisów są sprawdzane przy odczycie
+    m_count = int(header.stationCount);
+    m_stringCount = header.stringCount;
+    m_charCount = header.charCount;
+    m_savedAt = header.savedAt;
+    m_contentHash = header.contentHash;
+
+    const uchar *cursor = m_map + sizeof(SnapshotHeader);
+    m_records = reinterpret_cast<const SnapshotRecord *>(cursor);
+    cursor += qsizetype(m_count) * sizeof(SnapshotRecord);
+    m_ids = reinterpret_cast<const qint32 *>(cursor);
+    cursor += qsizetype(m_count) * sizeof(IdEntry);
+    m_offsets = reinterpret_cast<const quint32 *>(cursor);
+    cursor += (qsizetype(m_stringCount) + 1) * sizeof(quint32);
+    m_chars = reinterpret_cast<const char16_t *>(cursor);
+    return true;
+}
+
+void StationSnapshot::close()
+{
+    if (m_map)
+        m_file.unmap(m_map);
+    m_map = nullptr;
+    m_records = nullptr;
+    m_ids = nullptr;
+    m_offsets = nullptr;
+    m_chars = nullptr;
+    m_count = 0;
+    m_stringCount = 0;
+    m_charCount = 0;
+    m_savedAt = 0;
+    m_contentHash = 0;
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+QString StationSnapshot::string(quint32 index) const
+{
+    if (index >= m_stringCount)
+        return QString();
+    const quint32 begin = m_offsets[index];
+    const quint32 end = m_offsets[index + 1];
+    if (begin > end || end > m_charCount)
+        return QString();
+    // Kopia, bo wiersze żyją dłużej niż mapowanie pliku
+    return QString(reinterpret_cast<const QChar *>(m_chars + begin), qsizetype(end - begin));
+}
+
+Station StationSnapshot::station(int row) const
+{
+    Station station;
+    if (row < 0 || row >= m_count)
+        return station;
+
+    SnapshotRecord record;
+    std::memcpy(&record, m_records + row, sizeof(record));
+    station.id = record.id;
+    station.name = string(record.name);
+    station.cityName = string(record.cityName);
+    station.communeName = string(record.communeName);
+    station.districtName = string(record.districtName);
+    station.provinceName = string(record.provinceName);
+    station.latitude = record.latitude;
+    station.longitude = record.longitude;
+    return station;
+}
+
+int StationSnapshot::rowOf(int stationId) const
+{
+    const IdEntry *first = reinterpret_cast<const IdEntry *>(m_ids);
+    const IdEntry *last = first + m_count;
+    const IdEntry *it = std::lower_bound(first, last, stationId, [](const IdEntry &entry, int id) {
+        return entry.id < id;
+    });
+    if (it == last || it->id != stationId || it->row < 0 || it->row >= m_count)
+        return -1;
+    return it->row;
+}
+
+QList<Station> StationSnapshot::stations() const
+{
+    TraceSpan span("snapshot decode", "parse");
+    QList<Station> result;
+    result.reserve(m_count);
+
+    // Napisy są współdzielone przez stacje, więc każdy dekodujemy raz
+    QVector<QString> strings(m_stringCount);
+    for (quint32 i = 0; i < m_stringCount; ++i)
+        strings[i] = string(i);
+    const auto lookup = [&strings](quint32 index) {
+        return index < quint32(strings.size()) ? strings[index] : QString();
+    };
+
+    for (int row = 0; row < m_count; ++row) {
+        SnapshotRecord record;
+        std::memcpy(&record, m_records + row, sizeof(record));
+        Station station;
+        station.id = record.id;
+        station.name = lookup(record.name);
+        station.cityName = lookup(record.cityName);
+        station.communeName = lookup(record.communeName);
+        station.districtName = lookup(record.districtName);
+        station.provinceName = lookup(record.provinceName);
+        station.latitude = record.latitude;
+        station.longitude = record.longitude;
+        result.append(station);
+    }
+    return result;
+}
+
+QByteArray StationSnapshot::serialize(const QList<Station> &stations, qint64 savedAt)
+{
+    TraceSpan span("snapshot serialize", "io");
+
+    // Tablica napisów bez powtórzeń
+    QHash<QString, quint32> interned;
+    QList<QString> strings;
+    quint64 charCount = 0;
+    const auto intern = [&](const QString &text) {
+        auto it = interned.constFind(text);
+        if (it != interned.cend())
+            return it.value();
+        const quint32 index = quint32(strings.size());
+        interned.insert(text, index);
+        strings.append(text);
+        charCount += quint64(text.size());
+        return index;
+    };
+
+    QVector<SnapshotRecord> records;
+    records.reserve(stations.size());
+    QVector<IdEntry> ids;
+    ids.reserve(stations.size());
+    for (qsizetype row = 0; row < stations.size(); ++row) {
+        const Station &station = stations[row];
+        SnapshotRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.id = station.id;
+        record.name = intern(station.name);
+        record.cityName = intern(station.cityName);
+        record.communeName = intern(station.communeName);
+        record.districtName = intern(station.districtName);
+        record.provinceName = intern(station.provinceName);
+        record.latitude = station.latitude;
+        record.longitude = station.longitude;
+        records.append(record);
+        ids.append(IdEntry{station.id, qint32(row)});
+    }
+    std::stable_sort(ids.begin(), ids.end(), [](const IdEntry &a, const IdEntry &b) { return a.id < b.id; });
+
+    QVector<quint32> offsets;
+    offsets.reserve(strings.size() + 1);
+    quint32 offset = 0;
+    for (const QString &text : strings) {
+        offsets.append(offset);
+        offset += quint32(text.size());
+    }
+    offsets.append(offset);
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = FormatVersion;
+    header.recordSize = sizeof(SnapshotRecord);
+    header.stationCount = quint32(stations.size());
+    header.stringCount = quint32(strings.size());
+    header.charCount = charCount;
+    header.savedAt = savedAt;
+
+    QByteArray data;
+    data.reserve(expectedSize(header));
+    data.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char *>(records.constData()), records.size() * sizeof(SnapshotRecord));
+    data.append(reinterpret_cast<const char *>(ids.constData()), ids.size() * sizeof(IdEntry));
+    data.append(reinterpret_cast<const char *>(offsets.constData()), offsets.size() * sizeof(quint32));
+    for (const QString &text : strings)
+        data.append(reinterpret_cast<const char *>(text.constData()), text.size() * sizeof(QChar));
+
+    // Skrót obejmuje wszystko za nagłówkiem, więc nie zależy od czasu pobrania
+    header.contentHash = fnv1a(data.constData() + sizeof(SnapshotHeader), data.size() - qsizetype(sizeof(SnapshotHeader)));
+    std::memcpy(data.data(), &header, sizeof(header));
+    return data;
+}
+
+quint64 StationSnapshot::contentHash(const QByteArray &snapshot)
+{
+    if (snapshot.size() < qsizetype(sizeof(SnapshotHeader)))
+        return 0;
+    SnapshotHeader header;
+    std::memcpy(&header, snapshot.constData(), sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != FormatVersion)
+        return 0;
+    return header.contentHash;
+}
+
+quint64 StationSnapshot::storedHash(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+    return contentHash(file.read(sizeof(SnapshotHeader)));
+}
+
+bool StationSnapshot::importJson(const QString &jsonPath, const QString &path)
+{
+    if (QFile::exists(path))
+        return false;
+    QFile json(jsonPath);
+    if (!json.open(QIODevice::ReadOnly))
+        return false;
+
+    QList<Station> stations;
+    QString error;
+    if (!GiosParser::parseStations(json.readAll(), stations, &error)) {
+        qDebug() << "Nie udało się odczytać starego katalogu stacji:" << jsonPath << error;
+        return false;
+    }
+
+    // Czas pobrania katalogu to czas ostatniego zapisu pliku JSON
+    const qint64 savedAt = QFileInfo(jsonPath).lastModified().toMSecsSinceEpoch();
+    const QByteArray data = serialize(stations, savedAt);
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qDebug() << "Nie udało się zapisać migawki katalogu stacji:" << path << file.errorString();
+        return false;
+    }
+    qDebug() << "Katalog stacji przeniesiony z" << jsonPath << "do" << path;
+    return true;
+}
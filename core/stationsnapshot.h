@@ -0,0 +1,113 @@
+#ifndef STATIONSNAPSHOT_H
+#define STATIONSNAPSHOT_H
+
+#include <QFile>
+#include <QList>
+#include <QString>
+#include "giosdata.h"
+
+/**
+ * @brief Nagłówek pliku migawki katalogu stacji (40 bajtów, natywna kolejność bajtów).
+ * @details Za nagłówkiem leżą kolejno: rekordy stacji w kolejności katalogu, indeks ID
+ * (pary ID, wiersz posortowane po ID), przesunięcia napisów (stringCount + 1 liczb)
+ * i znaki napisów w UTF-16.
+ */
+struct SnapshotHeader
+{
+    char magic[4];          ///< "GIOS".
+    quint16 version;        ///< Wersja formatu.
+    quint16 recordSize;     ///< sizeof(SnapshotRecord).
+    quint32 stationCount;   ///< Liczba stacji.
+    quint32 stringCount;    ///< Liczba różnych napisów.
+    quint64 charCount;      ///< Łączna długość napisów w znakach UTF-16.
+    qint64 savedAt;         ///< Czas pobrania katalogu w ms od epoki.
+    quint64 contentHash;    ///< Skrót zawartości za nagłówkiem (porównanie z nowym katalogiem).
+};
+static_assert(sizeof(SnapshotHeader) == 40, "SnapshotHeader musi mieć 40 bajtów");
+
+/**
+ * @brief Rekord stacji w migawce (40 bajtów); pola tekstowe to numery napisów z tablicy.
+ * @details Nazwy miast, gmin, powiatów i województw powtarzają się w wielu stacjach,
+ * więc każdy napis jest zapisany w pliku tylko raz.
+ */
+struct SnapshotRecord
+{
+    qint32 id;
+    quint32 name;
+    quint32 cityName;
+    quint32 communeName;
+    quint32 districtName;
+    quint32 provinceName;
+    double latitude;
+    double longitude;
+};
+static_assert(sizeof(SnapshotRecord) == 40, "SnapshotRecord musi mieć 40 bajtów");
+
+/**
+ * @brief Binarna migawka katalogu stacji otwierana przez mmap.
+ * @details Otwarcie sprawdza tylko nagłówek i rozmiar pliku, więc trwa tyle samo niezależnie
+ * od liczby stacji. Stacje są dekodowane dopiero przy odczycie wiersza; wyszukanie po ID
+ * to wyszukiwanie binarne w indeksie zapisanym w pliku.
+ */
+class StationSnapshot
+{
+public:
+    static constexpr const char *DefaultPath = "stacje.bin";
+    static constexpr const char *LegacyJsonPath = "stacje.json";  ///< Katalog zapisywany przez starsze wersje.
+
+    explicit StationSnapshot(const QString &path = DefaultPath);
+    ~StationSnapshot();
+
+    StationSnapshot(const StationSnapshot &) = delete;
+    StationSnapshot &operator=(const StationSnapshot &) = delete;
+
+    bool open();
+    void close();
+    bool isOpen() const { return m_map != nullptr; }
+
+    int size() const { return m_count; }
+    qint64 savedAt() const { return m_savedAt; }
+    quint64 contentHash() const { return m_contentHash; }
+
+    Station station(int row) const;
+    /**
+     * @brief Zwraca wiersz stacji o podanym ID albo -1.
+     */
+    int rowOf(int stationId) const;
+    QList<Station> stations() const;
+
+    /**
+     * @brief Koduje katalog do postaci migawki (nagłówek, rekordy, indeks ID, napisy bez powtórzeń).
+     */
+    static QByteArray serialize(const QList<Station> &stations, qint64 savedAt);
+    /**
+     * @brief Skrót zawartości z nagłówka zakodowanej migawki (wyniku serialize); 0 dla błędnych danych.
+     */
+    static quint64 contentHash(const QByteArray &snapshot);
+    /**
+     * @brief Skrót zawartości migawki zapisanej w pliku, odczytany z samego nagłówka; 0, gdy jej nie ma.
+     */
+    static quint64 storedHash(const QString &path = DefaultPath);
+    /**
+     * @brief Jednorazowa migracja: gdy migawki nie ma, tworzy ją z katalogu JSON zapisanego przez starsze wersje.
+     * @return true, gdy migawka została utworzona.
+     */
+    static bool importJson(const QString &jsonPath = LegacyJsonPath, const QString &path = DefaultPath);
+
+private:
+    QString string(quint32 index) const;
+
+    QFile m_file;
+    uchar *m_map = nullptr;
+    const SnapshotRecord *m_records = nullptr;
+    const qint32 *m_ids = nullptr;          ///< Pary (ID, wiersz) posortowane po ID.
+    const quint32 *m_offsets = nullptr;     ///< Początek napisu i w m_chars; m_offsets[stringCount] = charCount.
+    const char16_t *m_chars = nullptr;
+    int m_count = 0;
+    quint32 m_stringCount = 0;
+    quint64 m_charCount = 0;
+    qint64 m_savedAt = 0;
+    quint64 m_contentHash = 0;
+};
+
+#endif // STATIONSNAPSHOT_H
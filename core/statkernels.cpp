@@ -0,0 +1,282 @@
+#include "statkernels.h"
+#include "seriesstore.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POGODA_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr double MsPerHour = 3600000.0;
+
+// Width bitów ważności od pozycji i; bit i+Width-1 musi istnieć w bitmapie.
+// Następne słowo jest czytane tylko wtedy, gdy te bity naprawdę do niego sięgają
+template <int Width>
+inline unsigned validityBits(const quint64 *validity, qsizetype i)
+{
+    const qsizetype word = i >> 6;
+    const int shift = int(i & 63);
+    quint64 bits = validity[word] >> shift;
+    if (shift > 64 - Width)
+        bits |= validity[word + 1] << (64 - shift);
+    return unsigned(bits & ((1u << Width) - 1));
+}
+
+inline bool validAt(const quint64 *validity, qsizetype i)
+{
+    return (validity[i >> 6] >> (i & 63)) & 1;
+}
+
+void scalarRange(SeriesMoments &m, const qint64 *timestamps, const float *values, const quint64 *validity,
+                 qsizetype begin, qsizetype end, qint64 origin, float threshold)
+{
+    for (qsizetype i = begin; i < end; ++i) {
+        if (!validAt(validity, i))
+            continue;
+        const float value = values[i];
+        const double x = (timestamps[i] - origin) / MsPerHour;
+        ++m.count;
+        m.min = std::min(m.min, value);
+        m.max = std::max(m.max, value);
+        m.sum += value;
+        m.sumSquares += double(value) * value;
+        if (value > threshold)
+            ++m.exceedances;
+        m.sumX += x;
+        m.sumXY += x * value;
+        m.sumXX += x * x;
+    }
+}
+
+#ifdef POGODA_X86_KERNELS
+
+// Konwersja int64 -> double dla 0 <= x < 2^52 przez sztuczkę z mantysą
+constexpr qint64 Magic52 = 0x4330000000000000LL;
+
+__attribute__((target("sse2")))
+void sse2Range(SeriesMoments &m, const qint64 *timestamps, const float *values, const quint64 *validity,
+               qsizetype begin, qsizetype end, qint64 origin, float threshold)
+{
+    const __m128i bitSelect = _mm_setr_epi32(1, 2, 4, 8);
+    const __m128i magicI = _mm_set1_epi64x(Magic52);
+    const __m128d magicD = _mm_castsi128_pd(magicI);
+    const __m128i originV = _mm_set1_epi64x(origin);
+    const __m128d toHours = _mm_set1_pd(1.0 / MsPerHour);
+    const __m128 thresholdV = _mm_set1_ps(threshold);
+    const __m128 posInf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 negInf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+
+    __m128 minV = posInf, maxV = negInf;
+    __m128d sum = _mm_setzero_pd(), sumSq = _mm_setzero_pd();
+    __m128d sumX = _mm_setzero_pd(), sumXY = _mm_setzero_pd(), sumXX = _mm_setzero_pd();
+    qint64 count = 0, exceedances = 0;
+
+    qsizetype i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const unsigned bits = validityBits<4>(validity, i);
+        if (!bits)
+            continue;
+        const __m128i mask = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(int(bits)), bitSelect), bitSelect);
+        const __m128 maskPs = _mm_castsi128_ps(mask);
+        const __m128 raw = _mm_loadu_ps(values + i);
+        const __m128 v = _mm_and_ps(raw, maskPs);
+
+        count += __builtin_popcount(bits);
+        exceedances += __builtin_popcount(unsigned(_mm_movemask_ps(_mm_and_ps(_mm_cmpgt_ps(raw, thresholdV), maskPs))));
+        minV = _mm_min_ps(minV, _mm_or_ps(_mm_and_ps(maskPs, raw), _mm_andnot_ps(maskPs, posInf)));
+        maxV = _mm_max_ps(maxV, _mm_or_ps(_mm_and_ps(maskPs, raw), _mm_andnot_ps(maskPs, negInf)));
+
+        const __m128d vLo = _mm_cvtps_pd(v);
+        const __m128d vHi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        sum = _mm_add_pd(sum, _mm_add_pd(vLo, vHi));
+        sumSq = _mm_add_pd(sumSq, _mm_add_pd(_mm_mul_pd(vLo, vLo), _mm_mul_pd(vHi, vHi)));
+
+        const __m128i tLo = _mm_sub_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(timestamps + i)), originV);
+        const __m128i tHi = _mm_sub_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(timestamps + i + 2)), originV);
+        const __m128d mLo = _mm_castsi128_pd(_mm_unpacklo_epi32(mask, mask));
+        const __m128d mHi = _mm_castsi128_pd(_mm_unpackhi_epi32(mask, mask));
+        const __m128d xLo = _mm_and_pd(_mm_mul_pd(_mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(tLo, magicI)), magicD), toHours), mLo);
+        const __m128d xHi = _mm_and_pd(_mm_mul_pd(_mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(tHi, magicI)), magicD), toHours), mHi);
+        sumX = _mm_add_pd(sumX, _mm_add_pd(xLo, xHi));
+        sumXY = _mm_add_pd(sumXY, _mm_add_pd(_mm_mul_pd(xLo, vLo), _mm_mul_pd(xHi, vHi)));
+        sumXX = _mm_add_pd(sumXX, _mm_add_pd(_mm_mul_pd(xLo, xLo), _mm_mul_pd(xHi, xHi)));
+    }
+
+    alignas(16) float f[4];
+    alignas(16) double d[2];
+    _mm_store_ps(f, minV);
+    m.min = std::min({m.min, f[0], f[1], f[2], f[3]});
+    _mm_store_ps(f, maxV);
+    m.max = std::max({m.max, f[0], f[1], f[2], f[3]});
+    _mm_store_pd(d, sum);    m.sum += d[0] + d[1];
+    _mm_store_pd(d, sumSq);  m.sumSquares += d[0] + d[1];
+    _mm_store_pd(d, sumX);   m.sumX += d[0] + d[1];
+    _mm_store_pd(d, sumXY);  m.sumXY += d[0] + d[1];
+    _mm_store_pd(d, sumXX);  m.sumXX += d[0] + d[1];
+    m.count += count;
+    m.exceedances += exceedances;
+
+    scalarRange(m, timestamps, values, validity, i, end, origin, threshold);
+}
+
+__attribute__((target("avx2,fma")))
+inline double horizontalSum(__m256d v)
+{
+    const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+__attribute__((target("avx2,fma")))
+void avx2Range(SeriesMoments &m, const qint64 *timestamps, const float *values, const quint64 *validity,
+               qsizetype begin, qsizetype end, qint64 origin, float threshold)
+{
+    const __m256i bitSelect = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i magicI = _mm256_set1_epi64x(Magic52);
+    const __m256d magicD = _mm256_castsi256_pd(magicI);
+    const __m256i originV = _mm256_set1_epi64x(origin);
+    const __m256d toHours = _mm256_set1_pd(1.0 / MsPerHour);
+    const __m256 thresholdV = _mm256_set1_ps(threshold);
+    const __m256 posInf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256 negInf = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+
+    __m256 minV = posInf, maxV = negInf;
+    __m256d sum = _mm256_setzero_pd(), sumSq = _mm256_setzero_pd();
+    __m256d sumX = _mm256_setzero_pd(), sumXY = _mm256_setzero_pd(), sumXX = _mm256_setzero_pd();
+    qint64 count = 0, exceedances = 0;
+
+    qsizetype i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const unsigned bits = validityBits<8>(validity, i);
+        if (!bits)
+            continue;
+        const __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(int(bits)), bitSelect), bitSelect);
+        const __m256 maskPs = _mm256_castsi256_ps(mask);
+        const __m256 raw = _mm256_loadu_ps(values + i);
+        const __m256 v = _mm256_and_ps(raw, maskPs);
+
+        count += __builtin_popcount(bits);
+        exceedances += __builtin_popcount(unsigned(_mm256_movemask_ps(
+            _mm256_and_ps(_mm256_cmp_ps(raw, thresholdV, _CMP_GT_OQ), maskPs))));
+        minV = _mm256_min_ps(minV, _mm256_blendv_ps(posInf, raw, maskPs));
+        maxV = _mm256_max_ps(maxV, _mm256_blendv_ps(negInf, raw, maskPs));
+
+        const __m256d vLo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        const __m256d vHi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        sum = _mm256_add_pd(sum, _mm256_add_pd(vLo, vHi));
+        sumSq = _mm256_fmadd_pd(vLo, vLo, _mm256_fmadd_pd(vHi, vHi, sumSq));
+
+        const __m256i tLo = _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(timestamps + i)), originV);
+        const __m256i tHi = _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(timestamps + i + 4)), originV);
+        const __m256d mLo = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(mask)));
+        const __m256d mHi = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm256_extracti128_si256(mask, 1)));
+        const __m256d xLo = _mm256_and_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(tLo, magicI)), magicD), toHours), mLo);
+        const __m256d xHi = _mm256_and_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(tHi, magicI)), magicD), toHours), mHi);
+        sumX = _mm256_add_pd(sumX, _mm256_add_pd(xLo, xHi));
+        sumXY = _mm256_fmadd_pd(xLo, vLo, _mm256_fmadd_pd(xHi, vHi, sumXY));
+        sumXX = _mm256_fmadd_pd(xLo, xLo, _mm256_fmadd_pd(xHi, xHi, sumXX));
+    }
+
+    alignas(32) float f[8];
+    _mm256_store_ps(f, minV);
+    m.min = std::min(m.min, *std::min_element(f, f + 8));
+    _mm256_store_ps(f, maxV);
+    m.max = std::max(m.max, *std::max_element(f, f + 8));
+    m.sum += horizontalSum(sum);
+    m.sumSquares += horizontalSum(sumSq);
+    m.sumX += horizontalSum(sumX);
+    m.sumXY += horizontalSum(sumXY);
+    m.sumXX += horizontalSum(sumXX);
+    m.count += count;
+    m.exceedances += exceedances;
+
+    scalarRange(m, timestamps, values, validity, i, end, origin, threshold);
+}
+
+#endif // POGODA_X86_KERNELS
+
+StatKernels::Isa detectIsa()
+{
+#ifdef POGODA_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return StatKernels::Isa::Avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return StatKernels::Isa::Sse2;
+#endif
+    return StatKernels::Isa::Scalar;
+}
+
+} // namespace
+
+double SeriesMoments::slope() const
+{
+    if (count < 2)
+        return 0.0;
+    const double n = double(count);
+    const double denominator = n * sumXX - sumX * sumX;
+    return denominator != 0.0 ? (n * sumXY - sumX * sum) / denominator : 0.0;
+}
+
+StatKernels::Isa StatKernels::activeIsa()
+{
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+QList<StatKernels::Isa> StatKernels::availableIsas()
+{
+    QList<Isa> isas{Isa::Scalar};
+    if (activeIsa() >= Isa::Sse2)
+        isas << Isa::Sse2;
+    if (activeIsa() >= Isa::Avx2)
+        isas << Isa::Avx2;
+    return isas;
+}
+
+const char *StatKernels::isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Avx2: return "AVX2";
+    case Isa::Sse2: return "SSE2";
+    case Isa::Scalar: break;
+    }
+    return "scalar";
+}
+
+SeriesMoments StatKernels::computeWith(Isa isa, const qint64 *timestamps, const float *values, const quint64 *validity,
+                                       qsizetype begin, qsizetype end, qint64 origin, float threshold)
+{
+    SeriesMoments m;
+    if (begin >= end)
+        return m;
+
+    switch (isa) {
+#ifdef POGODA_X86_KERNELS
+    case Isa::Avx2:
+        avx2Range(m, timestamps, values, validity, begin, end, origin, threshold);
+        return m;
+    case Isa::Sse2:
+        sse2Range(m, timestamps, values, validity, begin, end, origin, threshold);
+        return m;
+#endif
+    default:
+        scalarRange(m, timestamps, values, validity, begin, end, origin, threshold);
+        return m;
+    }
+}
+
+SeriesMoments StatKernels::compute(const qint64 *timestamps, const float *values, const quint64 *validity,
+                                   qsizetype begin, qsizetype end, qint64 origin, float threshold)
+{
+    return computeWith(activeIsa(), timestamps, values, validity, begin, end, origin, threshold);
+}
+
+SeriesMoments StatKernels::compute(const SeriesColumns &series, float threshold)
+{
+    if (series.isEmpty())
+        return SeriesMoments();
+    return compute(series.timestamps(), series.values(), series.validity(),
+                   0, series.size(), series.timestamp(0), threshold);
+}
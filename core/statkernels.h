@@ -0,0 +1,59 @@
+#ifndef STATKERNELS_H
+#define STATKERNELS_H
+
+#include <QtGlobal>
+#include <QList>
+#include <limits>
+
+class SeriesColumns;
+
+/**
+ * @brief Sumy zebrane w jednym przebiegu po kolumnie wartości.
+ * @details Oś X regresji to czas w godzinach od punktu origin. Brakujące odczyty
+ * (wyzerowane bity w bitmapie ważności) są pomijane we wszystkich sumach.
+ */
+struct SeriesMoments
+{
+    qint64 count = 0;                                   ///< Liczba ważnych pomiarów.
+    float min = std::numeric_limits<float>::infinity(); ///< Minimum (inf, gdy brak pomiarów).
+    float max = -std::numeric_limits<float>::infinity();///< Maksimum (-inf, gdy brak pomiarów).
+    double sum = 0.0;                                   ///< Suma wartości.
+    double sumSquares = 0.0;                            ///< Suma kwadratów wartości.
+    qint64 exceedances = 0;                             ///< Liczba wartości powyżej progu.
+    double sumX = 0.0;                                  ///< Suma czasów (h).
+    double sumXY = 0.0;                                 ///< Suma iloczynów czas × wartość.
+    double sumXX = 0.0;                                 ///< Suma kwadratów czasów.
+
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+    double slope() const;
+};
+
+/**
+ * @brief Wektorowe jądra statystyk nad maskowanymi kolumnami float.
+ * @details Jeden, połączony przebieg liczy liczność, min, max, sumy, przekroczenia progu
+ * i sumy regresji liniowej. Implementacja (AVX2, SSE2 lub skalarna) wybierana jest
+ * w czasie działania na podstawie możliwości procesora. Żaden znacznik czasu w zakresie
+ * [begin, end) nie może być wcześniejszy niż origin.
+ */
+namespace StatKernels
+{
+enum class Isa {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+Isa activeIsa();
+QList<Isa> availableIsas();
+const char *isaName(Isa isa);
+
+SeriesMoments compute(const qint64 *timestamps, const float *values, const quint64 *validity,
+                      qsizetype begin, qsizetype end, qint64 origin,
+                      float threshold = std::numeric_limits<float>::infinity());
+SeriesMoments computeWith(Isa isa, const qint64 *timestamps, const float *values, const quint64 *validity,
+                          qsizetype begin, qsizetype end, qint64 origin,
+                          float threshold = std::numeric_limits<float>::infinity());
+SeriesMoments compute(const SeriesColumns &series, float threshold = std::numeric_limits<float>::infinity());
+}
+
+#endif // STATKERNELS_H
@@ -0,0 +1,236 @@
+#include "tracer.h"
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+
+std::atomic_bool Tracer::s_enabled{qEnvironmentVariableIntValue("POGODA_TRACE") != 0};
+
+namespace {
+
+constexpr int BucketsPerDoubling = 4;
+
+QElapsedTimer startTimer()
+{
+    QElapsedTimer timer;
+    timer.start();
+    return timer;
+}
+
+// Górna granica przedziału histogramu w ns; przedział 0 obejmuje czasy poniżej 1 µs
+qint64 bucketUpperNs(int index)
+{
+    return qint64(1000.0 * std::exp2(double(index) / BucketsPerDoubling));
+}
+
+void appendEscaped(QByteArray &out, const QString &text)
+{
+    for (const QChar c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += char(c.unicode());
+        } else if (c.unicode() < 0x20) {
+            out += ' ';
+        } else {
+            out += QString(c).toUtf8();
+        }
+    }
+}
+
+} // namespace
+
+void Tracer::Histogram::add(qint64 durationNs)
+{
+    ++count;
+    sumNs += durationNs;
+    minNs = qMin(minNs, durationNs);
+    maxNs = qMax(maxNs, durationNs);
+    const double micros = durationNs / 1000.0;
+    const int index = micros < 1.0 ? 0 : 1 + int(std::floor(BucketsPerDoubling * std::log2(micros)));
+    ++buckets[qMin(index, BucketCount - 1)];
+}
+
+qint64 Tracer::Histogram::quantileNs(double q) const
+{
+    if (count == 0)
+        return 0;
+    const qint64 target = qMax<qint64>(1, qint64(std::ceil(q * count)));
+    qint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= target)
+            return qMin(bucketUpperNs(i), maxNs);
+    }
+    return maxNs;
+}
+
+Tracer &Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+qint64 Tracer::now()
+{
+    static const QElapsedTimer timer = startTimer();
+    return timer.nsecsElapsed();
+}
+
+int Tracer::threadIndex()
+{
+    // Małe, stabilne numery wątków czytelniejsze w podglądzie niż identyfikatory systemowe
+    static std::atomic_int next{1};
+    thread_local const int index = next.fetch_add(1);
+    return index;
+}
+
+void Tracer::append(Event &&event)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_events.size() >= MaxEvents) {
+        ++m_droppedEvents;
+        return;
+    }
+    m_events.append(std::move(event));
+}
+
+void Tracer::span(const char *name, const char *category, qint64 startNs, qint64 endNs)
+{
+    append(Event{name, category, 'X', 0, startNs, endNs - startNs, threadIndex(), QString()});
+}
+
+void Tracer::asyncSpan(const char *name, const char *category, quint64 id, qint64 startNs, qint64 endNs,
+                       const QString &detail)
+{
+    const int thread = threadIndex();
+    QMutexLocker locker(&m_mutex);
+    if (m_events.size() + 2 > MaxEvents) {
+        m_droppedEvents += 2;
+        return;
+    }
+    m_events.append(Event{name, category, 'b', id, startNs, 0, thread, detail});
+    m_events.append(Event{name, category, 'e', id, endNs, 0, thread, QString()});
+}
+
+void Tracer::count(const QString &counter, qint64 delta)
+{
+    QMutexLocker locker(&m_mutex);
+    m_counters[counter] += delta;
+}
+
+void Tracer::recordLatency(const QString &metric, qint64 durationNs)
+{
+    QMutexLocker locker(&m_mutex);
+    m_histograms[metric].add(durationNs);
+}
+
+QHash<QString, qint64> Tracer::counters() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_counters;
+}
+
+QHash<QString, Tracer::Histogram> Tracer::histograms() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_histograms;
+}
+
+QString Tracer::metricsText() const
+{
+    const QHash<QString, qint64> counterValues = counters();
+    const QHash<QString, Histogram> histogramValues = histograms();
+
+    QString text;
+    QStringList names = counterValues.keys();
+    names.sort();
+    for (const QString &name : std::as_const(names))
+        text += QString("%1 %2\n").arg(name).arg(counterValues.value(name));
+
+    names = histogramValues.keys();
+    names.sort();
+    const auto ms = [](double ns) { return QString::number(ns / 1e6, 'f', 2); };
+    for (const QString &name : std::as_const(names)) {
+        const Histogram &h = histogramValues[name];
+        text += QString("%1 liczba=%2 średnia=%3 p50=%4 p90=%5 p99=%6 max=%7 ms\n")
+                    .arg(name).arg(h.count).arg(ms(h.meanNs()))
+                    .arg(ms(h.quantileNs(0.5)), ms(h.quantileNs(0.9)), ms(h.quantileNs(0.99)), ms(h.maxNs));
+    }
+    return text;
+}
+
+bool Tracer::writeChromeTrace(const QString &path, QString *error) const
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    QByteArray out;
+    out.reserve(1 << 20);
+    out += "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":";
+    out += QByteArray::number(m_droppedEvents);
+    out += "},\"traceEvents\":[\n";
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"pogoda\"}}";
+    for (const Event &event : m_events) {
+        out += ",\n{\"name\":\"";
+        out += event.name;
+        out += "\",\"cat\":\"";
+        out += event.category;
+        out += "\",\"ph\":\"";
+        out += event.phase;
+        out += "\",\"ts\":";
+        out += QByteArray::number(event.timestampNs / 1000.0, 'f', 3);
+        if (event.phase == 'X') {
+            out += ",\"dur\":";
+            out += QByteArray::number(event.durationNs / 1000.0, 'f', 3);
+        } else {
+            out += ",\"id\":\"0x";
+            out += QByteArray::number(event.id, 16);
+            out += '"';
+        }
+        out += ",\"pid\":1,\"tid\":";
+        out += QByteArray::number(event.thread);
+        if (!event.detail.isEmpty()) {
+            out += ",\"args\":{\"detail\":\"";
+            appendEscaped(out, event.detail);
+            out += "\"}";
+        }
+        out += '}';
+        if (out.size() > (1 << 20)) {
+            file.write(out);
+            out.clear();
+        }
+    }
+    out += "\n]}\n";
+    file.write(out);
+    locker.unlock();
+
+    if (!file.commit()) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void Tracer::clearEvents()
+{
+    QMutexLocker locker(&m_mutex);
+    m_events.clear();
+    m_droppedEvents = 0;
+}
+
+void Tracer::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_events.clear();
+    m_droppedEvents = 0;
+    m_counters.clear();
+    m_histograms.clear();
+}
@@ -0,0 +1,129 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <limits>
+
+/**
+ * @brief Instrumentacja: przedziały czasu etapów, liczniki i histogramy opóźnień.
+ * @details Tracer włącza się w trakcie działania (setEnabled, zmienna środowiskowa POGODA_TRACE=1).
+ * Wyłączony kosztuje w każdym punkcie pomiarowym jeden odczyt atomowej flagi, więc instrumentacja
+ * może zostać w kodzie produkcyjnym. Włączony zbiera zdarzenia pod muteksem, z limitem liczby zdarzeń;
+ * można je zapisać w formacie Chrome trace-event (chrome://tracing, Perfetto).
+ * Czasy są liczone zegarem monotonicznym, w nanosekundach od startu procesu.
+ */
+class Tracer
+{
+public:
+    /**
+     * @brief Histogram opóźnień w przedziałach logarytmicznych (4 na podwojenie, od 1 µs).
+     */
+    struct Histogram
+    {
+        static constexpr int BucketCount = 128;
+
+        qint64 count = 0;
+        qint64 sumNs = 0;
+        qint64 minNs = std::numeric_limits<qint64>::max();
+        qint64 maxNs = 0;
+        std::array<qint64, BucketCount> buckets{};
+
+        void add(qint64 durationNs);
+        /**
+         * @brief Przybliżony kwantyl (górna granica przedziału), w nanosekundach.
+         */
+        qint64 quantileNs(double q) const;
+        double meanNs() const { return count > 0 ? double(sumNs) / count : 0.0; }
+    };
+
+    static Tracer &instance();
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+    static qint64 now();
+
+    /**
+     * @brief Zapisuje zakończony przedział w bieżącym wątku.
+     * @param name Nazwa; musi być literałem lub żyć do końca programu.
+     */
+    void span(const char *name, const char *category, qint64 startNs, qint64 endNs);
+    /**
+     * @brief Zapisuje przedział niezwiązany z wątkiem, np. etap żądania HTTP; przedziały o tym samym id
+     * są w podglądzie zgrupowane w jednym wierszu.
+     */
+    void asyncSpan(const char *name, const char *category, quint64 id, qint64 startNs, qint64 endNs,
+                   const QString &detail = QString());
+    void count(const QString &counter, qint64 delta = 1);
+    void recordLatency(const QString &metric, qint64 durationNs);
+
+    QHash<QString, qint64> counters() const;
+    QHash<QString, Histogram> histograms() const;
+    /**
+     * @brief Liczniki i histogramy (liczba, średnia, p50, p90, p99, maksimum w ms) w postaci tekstu.
+     */
+    QString metricsText() const;
+
+    /**
+     * @brief Zapisuje zebrane zdarzenia w formacie Chrome trace-event JSON.
+     */
+    bool writeChromeTrace(const QString &path, QString *error = nullptr) const;
+    void clearEvents();
+    void clear();
+
+private:
+    struct Event
+    {
+        const char *name;
+        const char *category;
+        char phase;         ///< 'X' - przedział wątku, 'b'/'e' - początek/koniec przedziału asynchronicznego.
+        quint64 id;
+        qint64 timestampNs;
+        qint64 durationNs;
+        int thread;
+        QString detail;
+    };
+
+    static constexpr qsizetype MaxEvents = 1 << 20;   // ok. 1 mln zdarzeń, dalsze są liczone jako pominięte
+
+    Tracer() = default;
+    void append(Event &&event);
+    static int threadIndex();
+
+    mutable QMutex m_mutex;
+    QVector<Event> m_events;
+    qint64 m_droppedEvents = 0;
+    QHash<QString, qint64> m_counters;
+    QHash<QString, Histogram> m_histograms;
+
+    static std::atomic_bool s_enabled;
+};
+
+/**
+ * @brief Przedział czasu od konstrukcji do końca zakresu, zapisywany tylko przy włączonym tracerze.
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *name, const char *category = "app")
+        : m_name(name), m_category(category), m_start(Tracer::isEnabled() ? Tracer::now() : -1) {}
+    ~TraceSpan()
+    {
+        if (m_start >= 0)
+            Tracer::instance().span(m_name, m_category, m_start, Tracer::now());
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *m_name;
+    const char *m_category;
+    qint64 m_start;
+};
+
+#endif // TRACER_H
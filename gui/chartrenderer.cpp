@@ -0,0 +1,190 @@
+#include "chartrenderer.h"
+#include "downsample.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QSvgGenerator>
+#include <QThread>
+#include <QtCharts/QDateTimeAxis>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QValueAxis>
+#include <QtConcurrent>
+
+namespace {
+
+/**
+ * @brief Rysuje wykres na dowolnym urządzeniu bez widoku QChartView.
+ * @details Scena i wykres są tymczasowe, ale jak wszystkie elementy Graphics View muszą żyć
+ * w wątku GUI. Układ wykresu jest przeliczany przez zdarzenia odłożone po ustawieniu
+ * geometrii, więc obsługujemy je od razu.
+ */
+void renderScene(const ChartSpec &spec, const QSize &size, QPainter *painter, const QRectF &target)
+{
+    Q_ASSERT(QThread::currentThread() == QCoreApplication::instance()->thread());
+    QGraphicsScene scene;
+    QChart *chart = ChartRenderer::build(spec);
+    scene.addItem(chart);   // scena usuwa wykres razem ze sobą
+    const QRectF source(QPointF(0, 0), size);
+    chart->setGeometry(source);
+    // Tylko przeliczenie układu wykresu - inne zdarzenia (np. sygnały ApiManager) nie mogą się tu wykonać
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+    scene.setSceneRect(source);
+
+    painter->setRenderHint(QPainter::Antialiasing);
+    scene.render(painter, target, source);
+}
+
+} // namespace
+
+bool ChartSpec::addTrace(const SeriesKey &key, const RollupQuery &query, int pixelWidth)
+{
+    if (query.buckets.isEmpty())
+        return false;
+    level = qMax(level, query.level);
+
+    ChartTrace trace;
+    trace.key = key;
+    trace.name = query.level == RollupLevel::Raw ? key.paramCode
+                 : query.level == RollupLevel::Daily ? key.paramCode + " (średnia dobowa)"
+                                                     : key.paramCode + " (średnia miesięczna)";
+    trace.points.reserve(query.buckets.size());
+    for (const RollupBucket &bucket : query.buckets)
+        trace.points.append(QPointF(bucket.start, bucket.mean()));
+
+    // Więcej punktów niż pikseli nie poprawia wykresu, a spowalnia jego budowę i przesuwanie
+    trace.points = Downsample::lttb(trace.points, pixelWidth);
+    for (const QPointF &point : std::as_const(trace.points)) {
+        minY = qMin(minY, point.y());
+        maxY = qMax(maxY, point.y());
+    }
+    traces.append(trace);
+    return true;
+}
+
+ChartSpec ChartRenderer::fromStore(const SeriesStore &store, const QList<SeriesKey> &keys, qint64 from, qint64 to,
+                                   int pixelWidth)
+{
+    ChartSpec spec;
+    spec.from = from;
+    spec.to = to;
+    // Długie zakresy rysujemy z agregatów dobowych lub miesięcznych zamiast surowych pomiarów
+    for (const SeriesKey &key : keys)
+        spec.addTrace(key, store.query(key, from, to, pixelWidth), pixelWidth);
+    return spec;
+}
+
+ChartSpec ChartRenderer::fromSource(const SeriesSource &source, const QList<SeriesKey> &keys, qint64 from, qint64 to,
+                                    int pixelWidth)
+{
+    ChartSpec spec;
+    spec.from = from;
+    spec.to = to;
+    const RollupLevel level = SeriesRollup::levelFor(from, to, pixelWidth);
+    for (const SeriesKey &key : keys)
+        spec.addTrace(key, SeriesRollup::query(source(key, from, to), from, to, level), pixelWidth);
+    return spec;
+}
+
+QChart *ChartRenderer::build(const ChartSpec &spec)
+{
+    static const QList<QColor> colors = {Qt::red, Qt::blue, Qt::green, Qt::magenta, Qt::cyan, Qt::darkYellow, Qt::gray};
+
+    QChart *chart = new QChart();
+    chart->setTitle(spec.title);
+
+    for (qsizetype i = 0; i < spec.traces.size(); ++i) {
+        QLineSeries *series = new QLineSeries();
+        series->setName(spec.traces[i].name);
+        series->setColor(colors[i % colors.size()]);
+        series->replace(spec.traces[i].points);
+        chart->addSeries(series);
+    }
+
+    QDateTimeAxis *axisX = new QDateTimeAxis;
+    axisX->setFormat(spec.level == RollupLevel::Raw ? "dd.MM HH:mm"
+                     : spec.level == RollupLevel::Daily ? "dd.MM.yyyy" : "MM.yyyy");
+    axisX->setTitleText("Data");
+    axisX->setRange(QDateTime::fromMSecsSinceEpoch(spec.from), QDateTime::fromMSecsSinceEpoch(spec.to));
+    chart->addAxis(axisX, Qt::AlignBottom);
+
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setTitleText("Stężenie (µg/m³)");
+    chart->addAxis(axisY, Qt::AlignLeft);
+
+    for (QAbstractSeries *series : chart->series()) {
+        series->attachAxis(axisX);
+        series->attachAxis(axisY);
+    }
+    if (!spec.isEmpty())
+        axisY->setRange(spec.minY * 0.9, spec.maxY * 1.1);
+
+    chart->legend()->setVisible(true);
+    chart->legend()->setAlignment(Qt::AlignBottom);
+    return chart;
+}
+
+QImage ChartRenderer::render(const ChartSpec &spec, const QSize &size, qreal dpi)
+{
+    const qreal scale = dpi / 96.0;
+    QImage image((QSizeF(size) * scale).toSize(), QImage::Format_ARGB32_Premultiplied);
+    image.setDotsPerMeterX(qRound(dpi / 0.0254));
+    image.setDotsPerMeterY(qRound(dpi / 0.0254));
+    image.fill(Qt::white);
+
+    QPainter painter(&image);
+    renderScene(spec, size, &painter, QRectF(QPointF(0, 0), image.size()));
+    painter.end();
+    return image;
+}
+
+QString ChartRenderer::save(const ChartSpec &spec, const QString &path, const QSize &size, qreal dpi)
+{
+    if (QFileInfo(path).suffix().compare("svg", Qt::CaseInsensitive) == 0) {
+        QSvgGenerator generator;
+        generator.setFileName(path);
+        generator.setSize(size);
+        generator.setViewBox(QRect(QPoint(0, 0), size));
+        generator.setResolution(qRound(dpi));
+        generator.setTitle(spec.title);
+
+        QPainter painter;
+        if (!painter.begin(&generator))
+            return QString("Nie udało się utworzyć pliku %1").arg(path);
+        renderScene(spec, size, &painter, QRectF(QPointF(0, 0), size));
+        painter.end();
+        return QString();
+    }
+
+    if (!render(spec, size, dpi).save(path))
+        return QString("Nie udało się zapisać pliku %1").arg(path);
+    return QString();
+}
+
+QStringList ChartRenderer::renderAll(const QList<Job> &jobs, const SeriesSource &source, qint64 from, qint64 to,
+                                     const QSize &size, qreal dpi, const ProgressCallback &progress)
+{
+    // Odczyt archiwum i redukcja punktów nie dotykają obiektów GUI, więc idą do puli wątków
+    const int pixelWidth = qRound(size.width() * dpi / 96.0);
+    const QList<ChartSpec> specs = QtConcurrent::blockingMapped<QList<ChartSpec>>(jobs, [&](const Job &job) {
+        ChartSpec spec = fromSource(source, job.keys, from, to, pixelWidth);
+        spec.title = job.title;
+        return spec;
+    });
+
+    // Rysowanie wykresów tylko w wątku GUI
+    QStringList errors;
+    const int total = int(jobs.size());
+    for (int i = 0; i < total; ++i) {
+        // Zlecenia bez danych w zakresie są pomijane bez tworzenia pliku
+        if (!specs[i].isEmpty()) {
+            const QString error = save(specs[i], jobs[i].path, size, dpi);
+            if (!error.isEmpty())
+                errors << error;
+        }
+        if (progress)
+            progress(i + 1, total);
+    }
+    return errors;
+}
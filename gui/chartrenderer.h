@@ -0,0 +1,98 @@
+#ifndef CHARTRENDERER_H
+#define CHARTRENDERER_H
+
+#include <QImage>
+#include <QList>
+#include <QPointF>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <QtCharts/QChart>
+#include <functional>
+#include <limits>
+#include "seriesstore.h"
+
+/**
+ * @brief Seria wykresu gotowa do narysowania.
+ */
+struct ChartTrace
+{
+    SeriesKey key;              ///< Seria w magazynie lub archiwum.
+    QString name;               ///< Nazwa w legendzie.
+    QList<QPointF> points;      ///< Punkty (ms od epoki, wartość) po redukcji do szerokości wykresu.
+};
+
+/**
+ * @brief Opis wykresu niezależny od widżetów i wątku.
+ * @details Z jednego opisu powstaje zarówno wykres w oknie, jak i obraz renderowany bez okien.
+ */
+struct ChartSpec
+{
+    QString title = "Wykres parametrów pomiarowych";
+    qint64 from = 0;                                        ///< Początek osi czasu (ms od epoki).
+    qint64 to = 0;                                          ///< Koniec osi czasu.
+    RollupLevel level = RollupLevel::Raw;                   ///< Najgrubszy poziom wśród serii.
+    double minY = std::numeric_limits<double>::max();       ///< Najmniejsza wartość punktów.
+    double maxY = std::numeric_limits<double>::lowest();    ///< Największa wartość punktów.
+    QList<ChartTrace> traces;
+
+    /**
+     * @brief Dodaje serię z wyniku zapytania, zredukowaną metodą LTTB do pixelWidth punktów.
+     * @return false, gdy zapytanie nie zwróciło danych.
+     */
+    bool addTrace(const SeriesKey &key, const RollupQuery &query, int pixelWidth);
+    bool isEmpty() const { return traces.isEmpty(); }
+};
+
+/**
+ * @brief Budowa wykresów i renderowanie ich do obrazów bez wyświetlania okien.
+ * @details Opis wykresu (fromStore, fromSource) można przygotować w dowolnym wątku. Wykres
+ * (QChart w QGraphicsScene) korzysta ze stylu, palety i czcionek QApplication, więc build,
+ * render i save wolno wywoływać tylko w wątku GUI, także na platformie offscreen.
+ */
+namespace ChartRenderer
+{
+/**
+ * @brief Zlecenie renderowania jednego pliku.
+ */
+struct Job
+{
+    QList<SeriesKey> keys;      ///< Serie na wykresie.
+    QString title;              ///< Tytuł wykresu.
+    QString path;               ///< Plik wynikowy; rozszerzenie .svg wybiera grafikę wektorową.
+};
+
+using ProgressCallback = std::function<void(int done, int total)>;
+
+ChartSpec fromStore(const SeriesStore &store, const QList<SeriesKey> &keys, qint64 from, qint64 to, int pixelWidth);
+ChartSpec fromSource(const SeriesSource &source, const QList<SeriesKey> &keys, qint64 from, qint64 to, int pixelWidth);
+
+/**
+ * @brief Tworzy wykres z osiami i legendą; własność przechodzi na wywołującego.
+ */
+QChart *build(const ChartSpec &spec);
+
+/**
+ * @brief Renderuje wykres do obrazu.
+ * @param size Rozmiar logiczny wykresu (jak okno przy 96 DPI).
+ * @param dpi Rozdzielczość; obraz ma size * dpi / 96 pikseli, a napisy i linie są skalowane wektorowo.
+ */
+QImage render(const ChartSpec &spec, const QSize &size, qreal dpi = 96.0);
+
+/**
+ * @brief Zapisuje wykres do pliku PNG (lub innego formatu rastrowego) albo SVG.
+ * @return Pusty tekst przy powodzeniu, w przeciwnym razie opis błędu.
+ */
+QString save(const ChartSpec &spec, const QString &path, const QSize &size, qreal dpi = 96.0);
+
+/**
+ * @brief Renderuje zlecenia: odczyt serii i redukcja LTTB równolegle w puli wątków,
+ * rysowanie i zapis kolejno w wątku wywołującym, który musi być wątkiem GUI.
+ * @param source Źródło serii; musi być bezpieczne wątkowo.
+ * @return Opisy błędów nieudanych zleceń (pusta lista, gdy wszystkie się powiodły).
+ */
+QStringList renderAll(const QList<Job> &jobs, const SeriesSource &source, qint64 from, qint64 to,
+                      const QSize &size, qreal dpi = 96.0, const ProgressCallback &progress = ProgressCallback());
+}
+
+#endif // CHARTRENDERER_H
@@ -0,0 +1,93 @@
+#include "mainwindow.h"
+#include "chartrenderer.h"
+#include "measurementarchive.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <cstring>
+
+// Renderowanie wykresów wszystkich serii z archiwum do plików, bez otwierania okien
+static int renderAll(const QCommandLineParser &parser)
+{
+    const QDir directory(parser.value("render-all"));
+    if (!directory.mkpath(".")) {
+        qWarning() << "Nie można utworzyć katalogu" << directory.path();
+        return 1;
+    }
+
+    const QStringList dimensions = parser.value("size").split('x');
+    const QSize size(dimensions.value(0).toInt(), dimensions.value(1).toInt());
+    if (size.isEmpty()) {
+        qWarning() << "Nieprawidłowy rozmiar wykresu:" << parser.value("size");
+        return 2;
+    }
+    bool dpiOk = false;
+    const qreal dpi = parser.value("dpi").toDouble(&dpiOk);
+    if (!dpiOk || dpi <= 0) {
+        qWarning() << "Nieprawidłowa rozdzielczość:" << parser.value("dpi");
+        return 2;
+    }
+    const QString suffix = parser.value("format") == "svg" ? "svg" : "png";
+    const qint64 to = QDateTime::currentMSecsSinceEpoch();
+    const qint64 from = to - parser.value("days").toLongLong() * 24 * 3600 * 1000;
+
+    // Jeden wykres na parę (stacja, parametr)
+    const MeasurementArchive archive(parser.value("archive"));
+    QList<ChartRenderer::Job> jobs;
+    for (const SeriesKey &key : archive.keys()) {
+        ChartRenderer::Job job;
+        job.keys = {key};
+        job.title = QString("Stacja %1 - %2").arg(key.stationId).arg(key.paramCode);
+        job.path = directory.filePath(QString("%1_%2.%3").arg(key.stationId).arg(key.paramCode, suffix));
+        jobs.append(job);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const QStringList errors = ChartRenderer::renderAll(jobs,
+        [&archive](const SeriesKey &key, qint64 rangeFrom, qint64 rangeTo) {
+            return archive.read(key, rangeFrom, rangeTo);
+        }, from, to, size, dpi);
+    for (const QString &error : errors)
+        qWarning() << error;
+
+    QTextStream(stdout) << "Wyrenderowano " << jobs.size() - errors.size() << " z " << jobs.size()
+                        << " wykresów w " << timer.elapsed() << " ms\n";
+    return errors.isEmpty() ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    // Tryb wsadowy nie otwiera okien, więc działa też bez serwera wyświetlania
+    for (int i = 1; i < argc; ++i) {
+        // QCommandLineParser przyjmuje też postać --render-all=katalog
+        const bool batch = std::strcmp(argv[i], "--render-all") == 0
+                           || std::strncmp(argv[i], "--render-all=", 13) == 0;
+        if (batch && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({"render-all", "Renderuje wykresy wszystkich serii z archiwum do katalogu i kończy działanie.", "katalog"});
+    parser.addOption({"archive", "Katalog archiwum pomiarów (render-all).", "dir", "archiwum"});
+    parser.addOption({"days", "Zakres wykresów w dniach wstecz od teraz (render-all).", "n", "7"});
+    parser.addOption({"size", "Rozmiar logiczny wykresu (render-all).", "SZERxWYS", "800x600"});
+    parser.addOption({"dpi", "Rozdzielczość obrazów PNG (render-all).", "dpi", "96"});
+    parser.addOption({"format", "Format plików: png | svg (render-all).", "format", "png"});
+    parser.process(a);
+
+    if (parser.isSet("render-all"))
+        return renderAll(parser);
+
+    MainWindow w;
+    w.show();
+    return a.exec();
+}
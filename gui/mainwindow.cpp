@@ -0,0 +1,971 @@
+#include "mainwindow.h"
+#include "ui_mainwindow.h"
+#include <QMessageBox>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QJsonParseError>
+#include <QFile>
+#include <QTextStream>
+#include <QListWidgetItem>
+#include <QTimer>
+#include <QStatusBar>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QValueAxis>
+#include <QtCharts/QDateTimeAxis>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <QFileDialog>
+#include <QPainter>
+#include <QDebug>
+#include "giosparser.h"
+#include "seriesanalysis.h"
+#include "downsample.h"
+#include "chartrenderer.h"
+#include "tracer.h"
+#include "regionreport.h"
+#include "seriesexport.h"
+#include "asyncwriter.h"
+#include "stationsnapshot.h"
+#include <QFutureWatcher>
+#include <QInputDialog>
+#include <QShortcut>
+#include <QtConcurrent>
+
+namespace {
+
+constexpr int ChartPixelWidth = 800;   ///< Domyślna szerokość okna wykresu.
+constexpr int NearbyStationCount = 3;  ///< Liczba najbliższych stacji w szczegółach stacji.
+
+} // namespace
+
+/**
+ * @brief Konstruktor okna głównego.
+ * @details Inicjalizuje interfejs graficzny, ustawia domyślne daty, konfiguruje połączenia sygnałów i tworzy pole filtrowania miast.
+ * @param parent Wskaźnik na nadrzędny widget.
+ */
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent)
+    , ui(new Ui::MainWindow)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Dane o pogodzie");
+
+    apiManager = &ApiManager::instance();
+    connect(apiManager, &ApiManager::requestFailed, this, [=](RequestKind, int, int, const QString &error) {
+        statusBar()->showMessage("Nie udało się pobrać danych z API: " + error, 5000);
+    });
+    connect(apiManager, &ApiManager::stationsReceived, this, [=](const QList<Station> &stations) {
+        // Katalog zgodny z wyświetlanym zostaje bez przeładowania listy (zachowuje przewinięcie i wybór)
+        const quint64 hash = apiManager->stationsHash();
+        if (hash != 0 && stationModel->contentHash() == hash) {
+            statusBar()->showMessage("Katalog stacji jest aktualny.", 3000);
+            return;
+        }
+        stationModel->setStations(stations, hash);
+    });
+    connect(apiManager, &ApiManager::sensorsReceived, this, [=](int stationId, const QList<Sensor> &sensors) {
+        if (stationId != lastStationId) {
+            return;
+        }
+        totalSensorsExpected = sensors.size();
+        for (const Sensor &sensor : sensors) {
+            if (!sensor.paramCode.isEmpty() && ui->paramListWidget->findItems(sensor.paramCode, Qt::MatchExactly).isEmpty()) {
+                ui->paramListWidget->addItem(sensor.paramCode);
+            }
+        }
+    });
+    connect(apiManager, &ApiManager::measurementsReceived, this, [=](const MeasurementSeries &series) {
+        const SeriesKey key{series.stationId, series.paramCode};
+        const SeriesColumns columns = SeriesStore::columnsFromPoints(series.values);
+
+        // Archiwum gromadzi historię dłuższą niż okno zwracane przez API; z dysku czytamy ją
+        // tylko przy pierwszym wczytaniu serii, w wątku roboczym, później dopisujemy wyłącznie nowe pomiary.
+        // Zapis do archiwum idzie przez wątek zapisu, więc magazyn scala nowe dane sam
+        if (!seriesStore.contains(key)) {
+            seriesStore.insert(key, columns);
+            loadSeriesHistory(key);
+        } else {
+            seriesStore.merge(key, columns);
+        }
+        AsyncWriter::instance().ingest(archive, key, columns);
+
+        if (series.stationId != lastStationId) {
+            return;
+        }
+
+        const QString &paramCode = series.paramCode;
+
+        if (ui->paramListWidget->findItems(paramCode, Qt::MatchExactly).isEmpty()) {
+            ui->paramListWidget->addItem(paramCode);
+        }
+
+        QString result = QString("• %1:\n").arg(paramCode);
+        int count = 0;
+
+        for (const MeasurementPoint &point : series.values) {
+            if (point.valid) {
+                result += QString("  %1 → %2 µg/m³\n").arg(point.date, QString::number(point.value));
+                if (++count >= 3) break;
+            }
+        }
+
+        if (count == 0)
+            result += "  brak danych\n";
+
+        measurementResults << result;
+        sensorsReceived++;
+        lastParamCode = paramCode;
+
+        if (sensorsReceived == totalSensorsExpected && totalSensorsExpected > 0) {
+            QString fullText = "Dane pomiarowe ze stacji:\n\n" + measurementResults.join("\n");
+            QMessageBox::information(this, "Dane pomiarowe", fullText);
+            measurementResults.clear();
+            sensorsReceived = 0; // Reset po wyświetleniu
+
+            const ApiManager::CacheStats stats = apiManager->cacheStats();
+            statusBar()->showMessage(QString("Cache HTTP: %1 trafień, %2 pobrań z sieci, %3 rewalidacji")
+                                         .arg(stats.hits).arg(stats.misses).arg(stats.revalidations));
+        }
+    });
+
+    // Błędy wątku zapisu (archiwum, migawka katalogu) trafiają tu przez kolejkę zdarzeń.
+    // Wątek GUI nie czeka na pełną kolejkę zapisu - jego zapisy są wtedy scalane albo odrzucane
+    AsyncWriter::instance().setNonBlockingThread(thread());
+    connect(&AsyncWriter::instance(), &AsyncWriter::writeFailed, this, [=](const QString &path, const QString &error) {
+        statusBar()->showMessage(QString("Nie udało się zapisać %1: %2").arg(path, error), 10000);
+    });
+
+    analysisService = new AnalysisService(this);
+    connect(analysisService, &AnalysisService::resultReady, this, &MainWindow::onAnalysisResult);
+    connect(analysisService, &AnalysisService::finished, this, &MainWindow::onAnalysisFinished);
+    connect(analysisService, &AnalysisService::progress, this, [=](int done, int total) {
+        statusBar()->showMessage(QString("Analiza: %1 z %2 parametrów").arg(done).arg(total));
+    });
+
+    exporter = new SeriesExporter(this);
+    connect(exporter, &SeriesExporter::progress, this, [=](int done, int total) {
+        statusBar()->showMessage(QString("Eksport: %1 z %2").arg(done).arg(total));
+    });
+    connect(exporter, &SeriesExporter::finished, this, [=](bool ok, const QString &error) {
+        statusBar()->clearMessage();
+        if (ok) {
+            QMessageBox::information(this, "Zapisano", "Eksport zakończony.");
+        } else {
+            QMessageBox::warning(this, "Błąd eksportu", error);
+        }
+    });
+
+    // Ctrl+Shift+T włącza śledzenie; wyłączenie zapisuje ślad w formacie Chrome trace-event
+    auto *traceShortcut = new QShortcut(QKeySequence("Ctrl+Shift+T"), this);
+    connect(traceShortcut, &QShortcut::activated, this, &MainWindow::toggleTracing);
+
+    connect(ui->drawButton, &QPushButton::clicked, this, &MainWindow::on_drawButton_clicked);
+    connect(ui->refreshButton, &QPushButton::clicked, this, &MainWindow::on_refreshButton_clicked);
+
+    ui->startDateTimeEdit->setDateTime(QDateTime(QDate::currentDate().addDays(-7), QTime::currentTime()));
+    ui->endDateTimeEdit->setDateTime(QDateTime(QDate::currentDate(), QTime::currentTime()));
+
+    stationModel = new StationListModel(this);
+    stationProxy = new StationFilterProxy(this);
+    stationProxy->setSourceModel(stationModel);
+    ui->stationListView->setModel(stationProxy);
+    ui->stationListView->setUniformItemSizes(true);
+
+    cityFilterLineEdit = new QLineEdit(this);
+    cityFilterLineEdit->setPlaceholderText("Szukaj stacji (miasto, nazwa, gmina)...");
+    cityFilterLineEdit->setGeometry(0, 430, 331, 30);
+    connect(cityFilterLineEdit, &QLineEdit::textChanged, this, [=](const QString &text) {
+        filterStationsByCity(text);
+    });
+
+    // Zimny start: lista z migawki zaraz po jej odczycie, a w tle sprawdzenie katalogu w API
+    loadStationSnapshot(true);
+}
+
+/**
+ * @brief Ustawia dane testowe dla określonego parametru.
+ * @param param Kod parametru (np. "PM10").
+ * @param data Tablica JSON z danymi pomiarowymi.
+ */
+void MainWindow::setTestData(const QString& param, const QJsonArray& data) {
+    MeasurementSeries series;
+    series.paramCode = param;
+    series.values = GiosParser::measurementPointsFromJson(data);
+    seriesStore.ingest(lastStationId, series);
+}
+
+/**
+ * @brief Zwraca liczbę stacji w liście.
+ * @return Liczba stacji widocznych po filtrowaniu.
+ */
+int MainWindow::getStationListCount() const {
+    return stationProxy->rowCount();
+}
+
+/**
+ * @brief Destruktor okna głównego.
+ * @details Zwalnia zasoby interfejsu i zamyka wszystkie otwarte okna wykresów.
+ */
+MainWindow::~MainWindow()
+{
+    for (ChartWindow* chartWindow : openCharts) {
+        delete chartWindow;
+    }
+    openCharts.clear();
+    delete ui;
+}
+
+/**
+ * @brief Obsługuje kliknięcie przycisku pobierania danych o stacjach.
+ */
+void MainWindow::on_pushButton_clicked()
+{
+    apiManager->getAirStations();
+}
+
+/**
+ * @brief Wyświetla listę stacji w widżecie listy.
+ * @param json Dane JSON zawierające listę stacji.
+ */
+void MainWindow::showStationsInList(const QString &json)
+{
+    QList<Station> stations;
+    if (!GiosParser::parseStations(json.toUtf8(), stations)) {
+        QMessageBox::warning(this, "Błąd", "Nieprawidłowy format JSON.");
+        return;
+    }
+    showStationsInList(stations);
+}
+
+/**
+ * @brief Wyświetla listę stacji w widżecie listy.
+ * @param stations Zdekodowana lista stacji.
+ */
+void MainWindow::showStationsInList(const QList<Station> &stations)
+{
+    stationModel->setStations(stations);
+}
+
+/**
+ * @brief Obsługuje kliknięcie na stację w liście.
+ * @param index Wybrany wiersz listy.
+ */
+void MainWindow::on_stationListView_clicked(const QModelIndex &index)
+{
+    // Wiersz widoku zależy od filtra; stację identyfikujemy po jej ID
+    const std::optional<Station> selected = stationModel->stationById(index.data(StationListModel::IdRole).toInt());
+
+    if (selected) {
+        const Station station = *selected;
+
+        QString info;
+        info += "Nazwa: " + station.name + "\n";
+        info += "ID: " + QString::number(station.id) + "\n";
+
+        // Odpowiedzi dla poprzednio wybranej stacji nie są już potrzebne
+        if (lastStationId != -1) {
+            apiManager->cancelStation(lastStationId);
+        }
+        lastStationId = station.id;
+
+        info += "Miasto: " + station.cityName + "\n";
+        info += "Województwo: " + station.provinceName + "\n";
+        info += "Powiat: " + station.districtName + "\n";
+
+        if (station.hasLocation()) {
+            // Najbliższe stacje z indeksu przestrzennego (pierwsze trafienie to sama stacja)
+            const QVector<StationGeoIndex::Hit> hits =
+                stationModel->geoIndex().nearest(station.latitude, station.longitude, NearbyStationCount + 1);
+            QStringList nearby;
+            for (const StationGeoIndex::Hit &hit : hits) {
+                const Station &other = stationModel->stations()[hit.row];
+                if (other.id != station.id) {
+                    nearby << QString("  %1 (%2 km)").arg(other.name, QString::number(hit.distanceKm, 'f', 1));
+                }
+            }
+            if (!nearby.isEmpty()) {
+                info += "Najbliższe stacje:\n" + nearby.mid(0, NearbyStationCount).join("\n") + "\n";
+            }
+        }
+
+        QMessageBox::information(this, "Szczegóły stacji", info);
+
+        measurementResults.clear();
+        sensorsReceived = 0;
+        totalSensorsExpected = 0;
+        ui->paramListWidget->clear();
+        apiManager->getSensorsForStation(lastStationId);
+    }
+}
+
+/**
+ * @brief Obsługuje wczytywanie zapisanych danych stacji.
+ */
+void MainWindow::on_pushButton_2_clicked()
+{
+    loadStationSnapshot(false);
+}
+
+/**
+ * @brief Wczytuje migawkę katalogu stacji w wątku roboczym i wyświetla ją po odczycie.
+ * @details Wątek roboczy czeka na zakolejkowany zapis migawki, jednorazowo przenosi stacje.json
+ * z instalacji sprzed migawek i mapuje plik; wątek GUI tylko podmienia model listy.
+ */
+void MainWindow::loadStationSnapshot(bool startup)
+{
+    using SnapshotPtr = std::shared_ptr<StationSnapshot>;
+    auto *watcher = new QFutureWatcher<SnapshotPtr>(this);
+    connect(watcher, &QFutureWatcher<SnapshotPtr>::finished, this, [this, watcher, startup]() {
+        const SnapshotPtr snapshot = watcher->result();
+        watcher->deleteLater();
+        if (!snapshot) {
+            if (!startup) {
+                QMessageBox::warning(this, "Błąd", "Brak zapisanego katalogu stacji. Pobierz dane z API.");
+            }
+            return;
+        }
+        stationModel->setSnapshot(snapshot);
+        apiManager->setSavedStationsHash(snapshot->contentHash());
+        const QString savedAt = QDateTime::fromMSecsSinceEpoch(snapshot->savedAt()).toString("yyyy-MM-dd HH:mm");
+        statusBar()->showMessage(QString("Katalog stacji z %1 (%2 stacji).").arg(savedAt).arg(snapshot->size()), 5000);
+        if (startup) {
+            apiManager->getAirStations(RequestPriority::Refresh);
+        }
+    });
+    watcher->setFuture(QtConcurrent::run([]() -> SnapshotPtr {
+        AsyncWriter::instance().flush();
+        StationSnapshot::importJson();
+        auto snapshot = std::make_shared<StationSnapshot>();
+        if (!snapshot->open()) {
+            return nullptr;
+        }
+        return snapshot;
+    }));
+}
+
+/**
+ * @brief Odczytuje historię serii z archiwum w wątku roboczym i scala ją z magazynem.
+ * @details Pomiary odebrane z API w międzyczasie są scalane na wierzch historii, więc nowsze
+ * dane i korekty z API mają pierwszeństwo przed zapisanymi.
+ */
+void MainWindow::loadSeriesHistory(const SeriesKey &key)
+{
+    const MeasurementArchive reader(archive.directory());
+    auto *watcher = new QFutureWatcher<SeriesColumns>(this);
+    connect(watcher, &QFutureWatcher<SeriesColumns>::finished, this, [this, watcher, key]() {
+        const SeriesColumns history = watcher->result();
+        watcher->deleteLater();
+        // Seria mogła zostać usunięta z magazynu, zanim historia dotarła
+        if (history.isEmpty() || !seriesStore.contains(key)) {
+            return;
+        }
+        const SeriesColumns received = seriesStore.series(key);
+        seriesStore.insert(key, history);
+        seriesStore.merge(key, received);
+    });
+    watcher->setFuture(QtConcurrent::run([reader, key]() {
+        return reader.read(key);
+    }));
+}
+
+/**
+ * @brief Buduje klucz okna wykresu z wybranej stacji, parametrów i zakresu dat.
+ */
+QString MainWindow::chartKey() const
+{
+    QStringList params;
+    for (QListWidgetItem* item : ui->paramListWidget->selectedItems()) {
+        params << item->text();
+    }
+    params.sort();
+    const QString format = "yyyy-MM-dd HH:mm";
+    return QString("stacja %1: %2 (%3 - %4)")
+        .arg(lastStationId)
+        .arg(params.join(", "),
+             ui->startDateTimeEdit->dateTime().toString(format),
+             ui->endDateTimeEdit->dateTime().toString(format));
+}
+
+/**
+ * @brief Rysuje wykres dla wybranych parametrów.
+ * @details Tworzy wykres liniowy dla wielu parametrów w wybranym zakresie dat, z różnymi kolorami dla każdej serii.
+ */
+void MainWindow::drawChart()
+{
+    TraceSpan span("draw chart", "render");
+    QList<QListWidgetItem*> selectedItems = ui->paramListWidget->selectedItems();
+    if (selectedItems.isEmpty()) {
+        QMessageBox::warning(this, "Brak wyboru", "Wybierz przynajmniej jeden parametr.");
+        return;
+    }
+
+    QDateTime startDate = ui->startDateTimeEdit->dateTime();
+    QDateTime endDate = ui->endDateTimeEdit->dateTime();
+
+    QList<SeriesKey> keys;
+    for (QListWidgetItem* item : selectedItems) {
+        const SeriesKey key{lastStationId, item->text()};
+        if (seriesStore.contains(key)) {
+            keys.append(key);
+        }
+    }
+
+    const ChartSpec spec = ChartRenderer::fromStore(seriesStore, keys, startDate.toMSecsSinceEpoch(),
+                                                    endDate.toMSecsSinceEpoch(), ChartPixelWidth);
+    if (spec.isEmpty()) {
+        QMessageBox::warning(this, "Brak danych", "Brak danych do wyświetlenia dla wybranych parametrów.");
+        return;
+    }
+
+    QChart *chart = ChartRenderer::build(spec);
+    auto *axisX = qobject_cast<QDateTimeAxis*>(chart->axes(Qt::Horizontal).first());
+    auto *axisY = qobject_cast<QValueAxis*>(chart->axes(Qt::Vertical).first());
+    currentChartKeys.clear();
+    for (const ChartTrace &trace : spec.traces) {
+        currentChartKeys.append(trace.key);
+    }
+
+    currentChartView = new QChartView(chart);
+    currentChartView->setRenderHint(QPainter::Antialiasing);
+
+    const QString key = chartKey();
+    ChartWindow *chartWindow = new ChartWindow(key);
+    // Zamknięte okno jest usuwane razem z wykresem, zamiast wisieć ukryte do końca programu
+    chartWindow->setAttribute(Qt::WA_DeleteOnClose);
+    chartWindow->setCentralWidget(currentChartView);
+    chartWindow->resize(ChartPixelWidth, 600);
+    chartWindow->setWindowTitle("Wykres parametrów - " + key);
+    chartWindow->setOnCloseCallback([this, chartWindow](const QString &closedKey) {
+        openCharts.remove(closedKey);
+        if (currentChartView && chartWindow->centralWidget() == currentChartView) {
+            currentChartView = nullptr;
+            currentChartKeys.clear();
+        }
+    });
+    // Okno subskrybuje swoje serie i samo dopisuje pomiary przychodzące przy odświeżaniu;
+    // za nowymi danymi podąża tylko wykres, którego zakres sięgał bieżącej godziny
+    const bool followLatest = endDate.addSecs(3600) >= QDateTime::currentDateTime();
+    chartWindow->attach(&seriesStore, spec.level, axisX, axisY, spec.minY, spec.maxY, followLatest);
+    const QList<QAbstractSeries*> chartSeries = chart->series();
+    for (qsizetype i = 0; i < chartSeries.size(); ++i) {
+        chartWindow->addTrace(spec.traces[i].key, static_cast<QLineSeries*>(chartSeries[i]));
+    }
+    openCharts[key] = chartWindow;
+    chartWindow->show();
+}
+
+/**
+ * @brief Obsługuje rysowanie wykresu po kliknięciu przycisku.
+ * @details Sprawdza poprawność wybranych parametrów i dat, oraz zapobiega otwieraniu wielu okien dla tego samego wykresu.
+ */
+void MainWindow::on_drawButton_clicked()
+{
+    QList<QListWidgetItem*> selectedItems = ui->paramListWidget->selectedItems();
+    if (selectedItems.isEmpty()) {
+        QMessageBox::warning(this, "Brak wyboru", "Wybierz przynajmniej jeden parametr.");
+        return;
+    }
+
+    QDateTime startDate = ui->startDateTimeEdit->dateTime();
+    QDateTime endDate = ui->endDateTimeEdit->dateTime();
+    if (startDate >= endDate) {
+        QMessageBox::warning(this, "Błędna data", "Data początkowa musi być wcześniejsza niż końcowa.");
+        return;
+    }
+
+    // Sprawdź, czy okno wykresu tej stacji, parametrów i zakresu już istnieje
+    const QString key = chartKey();
+    if (openCharts.contains(key)) {
+        QMessageBox::information(this, "Informacja", "Wykres jest już otwarty.");
+        openCharts[key]->raise(); // Przenieś istniejące okno na wierzch
+        return;
+    }
+
+    drawChart();
+}
+
+/**
+ * @brief Obsługuje eksport danych pomiarowych.
+ * @details Eksportuje serie z archiwum dla wybranej stacji, stacji widocznych na liście
+ * lub całego archiwum, w zakresie dat z pól edycji. Zapis odbywa się strumieniowo
+ * w wątku roboczym, a postęp jest pokazywany na pasku stanu.
+ */
+void MainWindow::on_exportButton_clicked()
+{
+    if (exporter->isRunning()) {
+        QMessageBox::warning(this, "Eksport", "Poprzedni eksport jeszcze trwa.");
+        return;
+    }
+
+    const QStringList scopes = {"Wybrana stacja", "Stacje z listy", "Całe archiwum"};
+    bool ok = false;
+    const QString scope = QInputDialog::getItem(this, "Eksport", "Zakres stacji:", scopes, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+
+    QSet<int> stationIds;
+    if (scope == scopes[0]) {
+        if (lastStationId == -1) {
+            QMessageBox::warning(this, "Błąd", "Nie wybrano stacji do eksportu danych.");
+            return;
+        }
+        stationIds.insert(lastStationId);
+    } else if (scope == scopes[1]) {
+        for (int row = 0; row < stationProxy->rowCount(); ++row) {
+            stationIds.insert(stationProxy->index(row, 0).data(StationListModel::IdRole).toInt());
+        }
+    }
+
+    QSet<QString> params;
+    for (QListWidgetItem *item : ui->paramListWidget->selectedItems()) {
+        params.insert(item->text());
+    }
+
+    // Serie pobrane przed chwilą mogą jeszcze czekać w kolejce zapisu - bierzemy też klucze z magazynu
+    QSet<SeriesKey> candidates;
+    for (const SeriesKey &key : archive.keys()) {
+        candidates.insert(key);
+    }
+    for (const SeriesKey &key : seriesStore.keys()) {
+        candidates.insert(key);
+    }
+
+    ExportOptions options;
+    for (const SeriesKey &key : std::as_const(candidates)) {
+        if ((stationIds.isEmpty() || stationIds.contains(key.stationId))
+            && (params.isEmpty() || params.contains(key.paramCode))) {
+            options.keys.append(key);
+        }
+    }
+    if (scope != scopes[2] && stationIds.isEmpty()) {
+        options.keys.clear();
+    }
+    if (options.keys.isEmpty()) {
+        QMessageBox::warning(this, "Brak danych", "Brak danych do zapisania.");
+        return;
+    }
+    std::sort(options.keys.begin(), options.keys.end(), [](const SeriesKey &a, const SeriesKey &b) {
+        return a.stationId != b.stationId ? a.stationId < b.stationId : a.paramCode < b.paramCode;
+    });
+
+    const QStringList layouts = {"CSV - wiersz na pomiar", "CSV - kolumna na serię", "Binarny (GIOX)"};
+    const QString layout = QInputDialog::getItem(this, "Eksport", "Układ pliku:", layouts, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+    options.layout = static_cast<ExportOptions::Layout>(layouts.indexOf(layout));
+
+    const QList<QPair<QString, ExportOptions::Compression>> compressions = {
+        {"Bez kompresji", ExportOptions::Compression::None},
+        {"gzip", ExportOptions::Compression::Gzip},
+        {"zstd", ExportOptions::Compression::Zstd}
+    };
+    QStringList available;
+    for (const auto &compression : compressions) {
+        if (SeriesExporter::isSupported(compression.second)) {
+            available << compression.first;
+        }
+    }
+    if (available.size() > 1) {
+        const QString choice = QInputDialog::getItem(this, "Eksport", "Kompresja:", available, 0, false, &ok);
+        if (!ok) {
+            return;
+        }
+        for (const auto &compression : compressions) {
+            if (compression.first == choice) {
+                options.compression = compression.second;
+            }
+        }
+    }
+
+    options.from = ui->startDateTimeEdit->dateTime().toMSecsSinceEpoch();
+    options.to = ui->endDateTimeEdit->dateTime().toMSecsSinceEpoch();
+
+    const QString suggested = options.keys.size() == 1
+        ? QString("pomiar_%1_stacja_%2").arg(options.keys.first().paramCode).arg(options.keys.first().stationId)
+        : QString("eksport_%1_serii").arg(options.keys.size());
+    options.path = QFileDialog::getSaveFileName(this, "Zapisz eksport", suggested + SeriesExporter::suffixFor(options));
+    if (options.path.isEmpty()) {
+        return;
+    }
+
+    const MeasurementArchive reader(archive.directory());
+    auto drained = std::make_shared<std::once_flag>();
+    statusBar()->showMessage("Trwa eksport danych...");
+    exporter->start(options, [reader, drained](const SeriesKey &key, qint64 from, qint64 to) {
+        // Przed pierwszym odczytem wątek roboczy czeka, aż zakolejkowane pomiary trafią do archiwum
+        std::call_once(*drained, []() { AsyncWriter::instance().flush(); });
+        return reader.read(key, from, to);
+    });
+}
+
+/**
+ * @brief Obsługuje analizę danych pomiarowych w sposób wielowątkowy.
+ * @details Zbiera migawki serii wybranych parametrów i przekazuje je do AnalysisService.
+ * Wyniki pojawiają się w niemodalnym oknie w miarę ich obliczania; zamknięcie okna anuluje analizę.
+ */
+void MainWindow::on_analyzeButton_clicked()
+{
+    QList<QListWidgetItem*> selectedItems = ui->paramListWidget->selectedItems();
+    if (selectedItems.isEmpty()) {
+        QMessageBox::warning(this, "Błąd", "Wybierz przynajmniej jeden parametr do analizy.");
+        return;
+    }
+
+    // Migawki danych powstają w wątku GUI - wątki robocze nie dotykają magazynu ani widżetów
+    QList<AnalysisService::Job> jobs;
+    analysisSections.clear();
+    analysisJobSections.clear();
+    for (QListWidgetItem* item : selectedItems) {
+        const QString selectedParam = item->text();
+        const SeriesKey key{lastStationId, selectedParam};
+        if (!seriesStore.contains(key)) {
+            analysisSections << QString("Brak danych dla parametru %1.\n\n").arg(selectedParam);
+            continue;
+        }
+
+        const SeriesColumns data = seriesStore.series(key);
+        if (data.isEmpty()) {
+            analysisSections << QString("Brak pomiarów dla parametru %1.\n\n").arg(selectedParam);
+            continue;
+        }
+
+        analysisJobSections << analysisSections.size();
+        analysisSections << QString();
+        jobs << AnalysisService::Job{selectedParam, data, seriesStore.aggregate(key)};
+    }
+
+    if (analysisBox) {
+        analysisBox->close();
+    }
+    analysisBox = new QMessageBox(QMessageBox::Information, "Analiza danych", "Trwa analiza...",
+                                  QMessageBox::Cancel, this);
+    analysisBox->setAttribute(Qt::WA_DeleteOnClose);
+    analysisBox->setModal(false);
+    connect(analysisBox, &QMessageBox::finished, analysisService, &AnalysisService::cancel);
+    analysisBox->show();
+
+    //WIELOWĄTKOWOŚĆ
+    // Uruchom analizę równolegle dla wszystkich parametrów
+    if (jobs.isEmpty()) {
+        onAnalysisFinished(false);
+        return;
+    }
+    analysisService->start(jobs);
+}
+
+/**
+ * @brief Dopisuje wynik analizy jednego parametru do okna analizy.
+ * @param jobIndex Indeks zadania przekazanego do AnalysisService.
+ * @param result Wynik analizy.
+ */
+void MainWindow::onAnalysisResult(int jobIndex, const AnalysisResult &result)
+{
+    if (jobIndex < 0 || jobIndex >= analysisJobSections.size())
+        return;
+    analysisSections[analysisJobSections[jobIndex]] = SeriesAnalysis::format(result);
+    if (analysisBox) {
+        analysisBox->setText(analysisSections.join(QString()));
+    }
+}
+
+/**
+ * @brief Kończy analizę i zamienia przycisk anulowania na OK.
+ * @param cancelled Czy analiza została anulowana.
+ */
+void MainWindow::onAnalysisFinished(bool cancelled)
+{
+    statusBar()->clearMessage();
+    if (!analysisBox)
+        return;
+    if (cancelled) {
+        analysisBox->setText(analysisSections.join(QString()) + "Analiza została przerwana.");
+    } else {
+        analysisBox->setText(analysisSections.join(QString()));
+    }
+    analysisBox->setStandardButtons(QMessageBox::Ok);
+}
+
+/**
+ * @brief Zapisuje otwarty wykres do pliku PNG lub SVG.
+ * @details Wykres jest budowany ponownie z magazynu i renderowany poza ekranem, więc rozmiar
+ * pliku nie zależy od rozmiaru okna, a obraz PNG może mieć dowolną rozdzielczość.
+ */
+void MainWindow::on_exportChartButton_clicked()
+{
+    if (!currentChartView || currentChartKeys.isEmpty()) {
+        QMessageBox::warning(this, "Błąd", "Nie ma otwartego wykresu do eksportu.");
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(this, "Zapisz wykres jako...",
+                                                    "wykres_parametrow.png",
+                                                    "Obraz PNG (*.png);;Grafika SVG (*.svg)");
+    if (fileName.isEmpty())
+        return;
+
+    int dpi = 96;
+    if (!fileName.endsWith(".svg", Qt::CaseInsensitive)) {
+        bool ok = false;
+        dpi = QInputDialog::getInt(this, "Eksport wykresu", "Rozdzielczość (DPI):", 192, 72, 1200, 24, &ok);
+        if (!ok)
+            return;
+    }
+
+    // Zakres osi czasu okna, które mogło przesunąć się przy odświeżaniu
+    auto *axisX = qobject_cast<QDateTimeAxis*>(currentChartView->chart()->axes(Qt::Horizontal).value(0));
+    const qint64 from = axisX ? axisX->min().toMSecsSinceEpoch() : ui->startDateTimeEdit->dateTime().toMSecsSinceEpoch();
+    const qint64 to = axisX ? axisX->max().toMSecsSinceEpoch() : ui->endDateTimeEdit->dateTime().toMSecsSinceEpoch();
+    const QSize size(ChartPixelWidth, 600);
+    const ChartSpec spec = ChartRenderer::fromStore(seriesStore, currentChartKeys, from, to,
+                                                    qRound(size.width() * dpi / 96.0));
+
+    const QString error = ChartRenderer::save(spec, fileName, size, dpi);
+    if (error.isEmpty()) {
+        QMessageBox::information(this, "Sukces", "Wykres zapisano do pliku:\n" + fileName);
+    } else {
+        QMessageBox::warning(this, "Błąd", error);
+    }
+}
+
+/**
+ * @brief Obsługuje odświeżanie danych pomiarowych.
+ * @details Czyści poprzednie dane i inicjuje ponowne pobieranie danych dla wybranej stacji.
+ */
+void MainWindow::on_refreshButton_clicked()
+{
+    if (lastStationId == -1) {
+        QMessageBox::warning(this, "Błąd", "Nie wybrano stacji do odświeżenia.");
+        return;
+    }
+
+    apiManager->cancelStation(lastStationId);
+    measurementResults.clear();
+    sensorsReceived = 0;
+    totalSensorsExpected = 0;
+    ui->paramListWidget->clear();
+
+    // Otwarte wykresy zostają; nowe pomiary dopiszą się do nich po odebraniu odpowiedzi
+    QMessageBox::information(this, "Odświeżanie", "Rozpoczęto odświeżanie danych dla wybranej stacji.");
+    apiManager->getSensorsForStation(lastStationId);
+}
+
+/**
+ * @brief Tworzy raport regionalny dla wybranego parametru i zakresu dat.
+ * @details Dane wszystkich stacji pochodzą z archiwum pomiarów; obliczenia działają w puli
+ * wątków, a wynik jest pokazywany po zakończeniu, bez blokowania okna.
+ */
+void MainWindow::on_regionReportButton_clicked()
+{
+    QList<QListWidgetItem*> selectedItems = ui->paramListWidget->selectedItems();
+    const QString paramCode = selectedItems.isEmpty() ? lastParamCode : selectedItems.first()->text();
+    if (paramCode.isEmpty() || stationModel->rowCount() == 0) {
+        QMessageBox::warning(this, "Brak danych", "Pobierz listę stacji i wybierz parametr.");
+        return;
+    }
+
+    const QStringList levels = {"Województwa", "Powiaty", "Gminy"};
+    bool ok = false;
+    const QString choice = QInputDialog::getItem(this, "Raport regionalny", "Grupuj według:", levels, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+    const RegionLevel level = static_cast<RegionLevel>(levels.indexOf(choice));
+
+    const QList<Station> stations = stationModel->stations();
+    const qint64 from = ui->startDateTimeEdit->dateTime().toMSecsSinceEpoch();
+    const qint64 to = ui->endDateTimeEdit->dateTime().toMSecsSinceEpoch();
+    const MeasurementArchive reader(archive.directory());
+
+    auto *watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher]() {
+        QMessageBox::information(this, "Raport regionalny", watcher->result());
+        watcher->deleteLater();
+    });
+    statusBar()->showMessage("Trwa tworzenie raportu regionalnego...");
+    watcher->setFuture(QtConcurrent::run([=]() {
+        // Serie pobrane przed chwilą mogą jeszcze czekać w kolejce zapisu - raport ich nie pominie
+        AsyncWriter::instance().flush();
+        const QList<RegionRow> rows = RegionReport::compute(stations, paramCode, level,
+            [&reader](const SeriesKey &key, qint64 rangeFrom, qint64 rangeTo) {
+                return reader.read(key, rangeFrom, rangeTo);
+            }, from, to);
+        return RegionReport::format(paramCode, level, rows);
+    }));
+}
+
+/**
+ * @brief Włącza lub wyłącza śledzenie czasów etapów.
+ * @details Po wyłączeniu zebrane zdarzenia można zapisać do pliku JSON (chrome://tracing, Perfetto),
+ * a liczniki i histogramy opóźnień są pokazywane w oknie.
+ */
+void MainWindow::toggleTracing()
+{
+    if (!Tracer::isEnabled()) {
+        Tracer::instance().clear();
+        Tracer::setEnabled(true);
+        statusBar()->showMessage("Śledzenie włączone (Ctrl+Shift+T wyłącza)");
+        return;
+    }
+
+    Tracer::setEnabled(false);
+    statusBar()->clearMessage();
+    const QString fileName = QFileDialog::getSaveFileName(this, "Zapisz ślad", "slad.json", "Chrome trace (*.json)");
+    QString error;
+    if (!fileName.isEmpty() && !Tracer::instance().writeChromeTrace(fileName, &error)) {
+        QMessageBox::warning(this, "Błąd", "Nie udało się zapisać śladu: " + error);
+    }
+    QMessageBox::information(this, "Metryki", Tracer::instance().metricsText());
+}
+
+/**
+ * @brief Filtruje stacje według miasta, nazwy, gminy lub województwa.
+ * @details Zapytanie trafia do indeksu wyszukiwania zbudowanego przy wczytaniu katalogu,
+ * bez przeglądania wszystkich stacji i bez przebudowy listy.
+ * @param cityName Szukany tekst.
+ */
+void MainWindow::filterStationsByCity(const QString &cityName)
+{
+    stationProxy->setSearchText(cityName);
+}
+
+/**
+ * @brief Podłącza okno wykresu do sygnałów magazynu serii.
+ */
+void ChartWindow::attach(const SeriesStore *store, RollupLevel level, QDateTimeAxis *axisX, QValueAxis *axisY,
+                         double minY, double maxY, bool followLatest)
+{
+    m_followLatest = followLatest;
+    m_store = store;
+    m_level = level;
+    m_axisX = axisX;
+    m_axisY = axisY;
+    m_minY = minY;
+    m_maxY = maxY;
+    connect(store, &SeriesStore::seriesAppended, this, &ChartWindow::onSeriesAppended);
+    connect(store, &SeriesStore::seriesReset, this, &ChartWindow::onSeriesReset);
+}
+
+/**
+ * @brief Rejestruje serię wykresu dla klucza (stacja, parametr).
+ */
+void ChartWindow::addTrace(const SeriesKey &key, QLineSeries *series)
+{
+    m_traces.insert(key, series);
+}
+
+/**
+ * @brief Dopisuje do wykresu tylko pomiary nowsze niż ostatni narysowany punkt.
+ * @details Na poziomach dobowym i miesięcznym ostatni punkt jest zastępowany, gdy nowe
+ * pomiary trafiły do tego samego przedziału. Wykres zamkniętego zakresu pomija punkty
+ * późniejsze niż koniec osi czasu. Zmiana trafia do serii jednym wywołaniem replace();
+ * punkty, które wypadły z przewijanego okna, są usuwane, a po przekroczeniu szerokości
+ * wykresu seria jest ponownie przerzedzana LTTB, więc jej rozmiar pozostaje ograniczony.
+ */
+void ChartWindow::onSeriesAppended(const SeriesKey &key)
+{
+    TraceSpan span("chart append", "render");
+    QLineSeries *series = m_traces.value(key);
+    if (!series || !m_store) {
+        return;
+    }
+
+    const int last = series->count() - 1;
+    const qint64 from = last >= 0 ? qint64(series->at(last).x()) : m_axisX->min().toMSecsSinceEpoch();
+    const qint64 to = m_followLatest ? std::numeric_limits<qint64>::max() : m_axisX->max().toMSecsSinceEpoch();
+    if (from > to) {
+        return;
+    }
+    const RollupQuery delta = m_store->query(key, from, to, m_level);
+    if (delta.buckets.isEmpty()) {
+        return;
+    }
+
+    QList<QPointF> merged = series->points();
+    QList<QPointF> points;
+    points.reserve(delta.buckets.size());
+    qint64 newest = from;
+    for (const RollupBucket &bucket : delta.buckets) {
+        const QPointF point(bucket.start, bucket.mean());
+        if (!merged.isEmpty() && merged.last().x() == point.x()) {
+            merged.last() = point;
+        } else {
+            merged.append(point);
+        }
+        points.append(point);
+        newest = qMax(newest, bucket.start);
+    }
+    updateRanges(newest, points);
+
+    // Zostawiamy jeden punkt sprzed początku osi, żeby linia dochodziła do lewej krawędzi
+    if (m_followLatest) {
+        const qreal axisMin = m_axisX->min().toMSecsSinceEpoch();
+        const auto visible = std::lower_bound(merged.cbegin(), merged.cend(), axisMin,
+                                              [](const QPointF &point, qreal x) { return point.x() < x; });
+        const qsizetype drop = qMax<qsizetype>(0, (visible - merged.cbegin()) - 1);
+        merged.remove(0, drop);
+    }
+    if (merged.size() > ChartPixelWidth) {
+        merged = Downsample::lttb(merged, ChartPixelWidth);
+    }
+    series->replace(merged);
+}
+
+/**
+ * @brief Odczytuje serię od nowa w bieżącym zakresie osi (po korekcie lub wymianie danych).
+ */
+void ChartWindow::onSeriesReset(const SeriesKey &key)
+{
+    TraceSpan span("chart reset", "render");
+    QLineSeries *series = m_traces.value(key);
+    if (!series || !m_store) {
+        return;
+    }
+
+    const RollupQuery query = m_store->query(key, m_axisX->min().toMSecsSinceEpoch(),
+                                             m_axisX->max().toMSecsSinceEpoch(), m_level);
+    QList<QPointF> points;
+    points.reserve(query.buckets.size());
+    for (const RollupBucket &bucket : query.buckets) {
+        points.append(QPointF(bucket.start, bucket.mean()));
+    }
+    points = Downsample::lttb(points, ChartPixelWidth);
+    series->replace(points);
+    updateRanges(points.isEmpty() ? 0 : qint64(points.last().x()), points);
+}
+
+/**
+ * @brief Przesuwa oś czasu, by obejmowała najnowszy punkt, i rozszerza oś wartości.
+ * @details Szerokość okna czasowego pozostaje stała - wykres „przewija się” wraz z danymi,
+ * o ile zakres sięgał chwili obecnej w momencie rysowania.
+ */
+void ChartWindow::updateRanges(qint64 newest, const QList<QPointF> &points)
+{
+    const qint64 axisMin = m_axisX->min().toMSecsSinceEpoch();
+    const qint64 axisMax = m_axisX->max().toMSecsSinceEpoch();
+    if (m_followLatest && newest > axisMax) {
+        const qint64 span = axisMax - axisMin;
+        m_axisX->setRange(QDateTime::fromMSecsSinceEpoch(newest - span), QDateTime::fromMSecsSinceEpoch(newest));
+    }
+
+    bool grown = false;
+    for (const QPointF &point : points) {
+        if (point.y() < m_minY) {
+            m_minY = point.y();
+            grown = true;
+        }
+        if (point.y() > m_maxY) {
+            m_maxY = point.y();
+            grown = true;
+        }
+    }
+    if (grown) {
+        m_axisY->setRange(m_minY * 0.9, m_maxY * 1.1);
+    }
+}
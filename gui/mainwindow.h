@@ -0,0 +1,240 @@
+#ifndef MAINWINDOW_H
+#define MAINWINDOW_H
+
+#include <QMainWindow>
+#include "apimanager.h"
+#include "seriesstore.h"
+#include "measurementarchive.h"
+#include "analysisservice.h"
+#include "stationmodel.h"
+#include "seriesexport.h"
+#include <QJsonArray>
+#include <QListWidgetItem>
+#include <QSet>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QDateTimeAxis>
+#include <QtCharts/QValueAxis>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPointer>
+
+class ChartWindow;
+
+QT_BEGIN_NAMESPACE
+namespace Ui {
+class MainWindow;
+}
+QT_END_NAMESPACE
+
+/**
+ * @brief Główna klasa okna aplikacji do monitorowania jakości powietrza.
+ * @details Odpowiada za interfejs graficzny, obsługę danych z API GIOŚ oraz wyświetlanie wykresów i analiz.
+ */
+class MainWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor okna głównego.
+     * @param parent Wskaźnik na nadrzędny widget.
+     */
+    explicit MainWindow(QWidget *parent = nullptr);
+    void setTestData(const QString& param, const QJsonArray& data); // Metoda testowa
+    int getStationListCount() const; // Nowa metoda do testów
+    /**
+     * @brief Wyświetla listę stacji w widżecie listy.
+     * @param json Dane JSON zawierające listę stacji.
+     */
+    void showStationsInList(const QString &json);
+    /**
+     * @brief Wyświetla zdekodowaną listę stacji w widżecie listy.
+     * @param stations Lista stacji z ApiManager.
+     */
+    void showStationsInList(const QList<Station> &stations);
+    /**
+     * @brief Slot dla przycisku analizy danych.
+     */
+    void on_analyzeButton_clicked();
+    /**
+     * @brief Filtruje stacje według miasta, nazwy, gminy lub województwa.
+     * @details Każde słowo jest dopasowywane jako podciąg, także przy 1-2 znakach, więc wyniki
+     * tylko się zawężają w miarę pisania.
+     * @param cityName Szukany tekst (wielkość liter i polskie znaki nie mają znaczenia).
+     */
+    void filterStationsByCity(const QString &cityName);
+
+    /**
+     * @brief Destruktor okna głównego.
+     */
+    ~MainWindow();
+
+private slots:
+    /**
+     * @brief Slot dla przycisku pobierania danych o stacjach.
+     */
+    void on_pushButton_clicked();
+    /**
+     * @brief Slot dla kliknięcia na element listy stacji.
+     * @param index Indeks wybranego wiersza (w modelu filtra).
+     */
+    void on_stationListView_clicked(const QModelIndex &index);
+    /**
+     * @brief Slot dla przycisku wczytywania zapisanych danych stacji.
+     */
+    void on_pushButton_2_clicked();
+    /**
+     * @brief Slot dla przycisku rysowania wykresu.
+     */
+    void on_drawButton_clicked();
+    /**
+     * @brief Slot dla przycisku eksportu danych.
+     */
+    void on_exportButton_clicked();
+
+    /**
+     * @brief Slot dla przycisku eksportu wykresu.
+     */
+    void on_exportChartButton_clicked();
+    /**
+     * @brief Slot dla przycisku odświeżania danych pomiarowych.
+     */
+    void on_refreshButton_clicked();
+    /**
+     * @brief Slot dla przycisku raportu regionalnego (grupowanie po województwach, powiatach lub gminach).
+     */
+    void on_regionReportButton_clicked();
+    /**
+     * @brief Odbiera wynik analizy jednego parametru.
+     */
+    void onAnalysisResult(int jobIndex, const AnalysisResult &result);
+    /**
+     * @brief Obsługuje zakończenie (lub anulowanie) analizy.
+     */
+    void onAnalysisFinished(bool cancelled);
+    /**
+     * @brief Przełącza śledzenie czasów etapów i zapisuje zebrany ślad.
+     */
+    void toggleTracing();
+
+private:
+    Ui::MainWindow *ui;
+    ApiManager *apiManager;
+
+    /**
+     * @brief Rysuje wykres dla wybranych parametrów.
+     */
+    void drawChart();
+    /**
+     * @brief Zwraca klucz okna wykresu dla bieżącego wyboru (stacja, parametry, zakres dat).
+     */
+    QString chartKey() const;
+    /**
+     * @brief Wyświetla katalog stacji z migawki zapisanej po ostatnim pobraniu, odczytanej w tle.
+     * @param startup Przy starcie brak migawki nie jest błędem, a po wczytaniu katalog jest odświeżany z API.
+     */
+    void loadStationSnapshot(bool startup);
+    /**
+     * @brief Dołącza do serii jej historię z archiwum, odczytaną w tle.
+     */
+    void loadSeriesHistory(const SeriesKey &key);
+
+
+    StationListModel* stationModel = nullptr;   ///< Katalog stacji.
+    StationFilterProxy* stationProxy = nullptr; ///< Filtr wyszukiwania nad katalogiem stacji.
+    QStringList measurementResults;
+    int totalSensorsExpected = 0;   ///< Oczekiwana liczba czujników.
+    int sensorsReceived = 0;        ///< Liczba odebranych czujników.
+    SeriesStore seriesStore;        ///< Kolumnowy magazyn serii pomiarowych (stacja, parametr).
+    MeasurementArchive archive;     ///< Trwałe archiwum historycznych pomiarów.
+    QString lastParamCode;          ///< Kod parametru ostatnio odebranej serii.
+    int lastStationId = -1;         ///< ID ostatnio wybranej stacji.
+    QSet<QString> drawnCharts;      ///< Zbiór narysowanych wykresów.
+    QMap<QString, ChartWindow*> openCharts; ///< Mapa otwartych okien wykresów.
+    QChartView* currentChartView = nullptr; ///< Aktualny widok wykresu.
+    QList<SeriesKey> currentChartKeys;      ///< Serie aktualnego wykresu (do eksportu obrazu).
+    QLineEdit* cityFilterLineEdit = nullptr; ///< Pole do filtrowania stacji po mieście.
+    AnalysisService* analysisService = nullptr; ///< Asynchroniczna analiza serii.
+    SeriesExporter* exporter = nullptr;         ///< Strumieniowy eksport serii z archiwum.
+    QPointer<QMessageBox> analysisBox;  ///< Niemodalne okno z wynikami analizy.
+    QStringList analysisSections;       ///< Sekcje tekstu analizy w kolejności parametrów.
+    QVector<int> analysisJobSections;   ///< Indeks sekcji dla każdego zadania analizy.
+};
+
+/**
+ * @brief Klasa okna wykresu.
+ * @details Odpowiada za wyświetlanie wykresów parametrów pomiarowych. Okno subskrybuje
+ * swoje serie w magazynie: nowe pomiary są dopisywane do istniejących QLineSeries,
+ * a osie przesuwane, bez przebudowy wykresu.
+ */
+class ChartWindow : public QMainWindow
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Konstruktor okna wykresu.
+     * @param chartKey Klucz wykresu w MainWindow::openCharts.
+     * @param parent Wskaźnik na nadrzędny widget.
+     */
+    explicit ChartWindow(const QString &chartKey, QWidget *parent = nullptr)
+        : QMainWindow(parent), m_chartKey(chartKey) {}
+
+    /**
+     * @brief Ustawia callback wywoływany przy zamykaniu okna.
+     * @param callback Funkcja do wywołania.
+     */
+    void setOnCloseCallback(std::function<void(const QString &)> callback) {
+        m_onClose = callback;
+    }
+
+    /**
+     * @brief Podłącza okno do magazynu serii.
+     * @param store Magazyn, którego zmiany mają aktualizować wykres.
+     * @param level Poziom szczegółowości, na którym narysowano wykres.
+     * @param axisX Oś czasu wykresu.
+     * @param axisY Oś wartości wykresu.
+     * @param minY Najmniejsza narysowana wartość.
+     * @param maxY Największa narysowana wartość.
+     * @param followLatest Czy wykres ma przewijać się za nowymi pomiarami (zakres sięgał chwili obecnej);
+     * wykres zamkniętego zakresu historycznego dopisuje tylko punkty mieszczące się na osi.
+     */
+    void attach(const SeriesStore *store, RollupLevel level, QDateTimeAxis *axisX, QValueAxis *axisY,
+                double minY, double maxY, bool followLatest);
+    /**
+     * @brief Dodaje serię wykresu powiązaną z serią w magazynie.
+     */
+    void addTrace(const SeriesKey &key, QLineSeries *series);
+
+private slots:
+    void onSeriesAppended(const SeriesKey &key);
+    void onSeriesReset(const SeriesKey &key);
+
+protected:
+    /**
+     * @brief Obsługuje zdarzenie zamknięcia okna.
+     * @details Odłącza okno od magazynu, żeby zamknięty wykres nie był już aktualizowany.
+     * @param event Wskaźnik na zdarzenie zamknięcia.
+     */
+    void closeEvent(QCloseEvent *event) override {
+        if (m_store) disconnect(m_store, nullptr, this, nullptr);
+        if (m_onClose) m_onClose(m_chartKey);
+        QMainWindow::closeEvent(event);
+    }
+
+private:
+    void updateRanges(qint64 newest, const QList<QPointF> &points);
+
+    QString m_chartKey; ///< Klucz wykresu w MainWindow::openCharts.
+    std::function<void(const QString &)> m_onClose; ///< Callback dla zamknięcia.
+    const SeriesStore *m_store = nullptr;       ///< Magazyn, z którego pochodzą dane.
+    RollupLevel m_level = RollupLevel::Raw;     ///< Poziom szczegółowości wykresu.
+    QDateTimeAxis *m_axisX = nullptr;           ///< Oś czasu.
+    QValueAxis *m_axisY = nullptr;              ///< Oś wartości.
+    double m_minY = 0.0;                        ///< Najmniejsza narysowana wartość.
+    double m_maxY = 0.0;                        ///< Największa narysowana wartość.
+    bool m_followLatest = false;                ///< Czy oś czasu przewija się za nowymi pomiarami.
+    QHash<SeriesKey, QLineSeries*> m_traces;    ///< Serie wykresu według klucza w magazynie.
+};
+
+#endif // MAINWINDOW_H
@@ -0,0 +1,82 @@
+#include "mockgiosserver.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QTextStream>
+#include <QTimer>
+#include <QDebug>
+
+static QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("pogoda-mockserver");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Lokalny serwer zastępujący API GIOŚ: dane syntetyczne, odtwarzanie nagrań "
+                                     "i wstrzykiwanie opóźnień oraz błędów.");
+    parser.addHelpOption();
+    parser.addOption({"address", "Adres nasłuchiwania.", "adres", "127.0.0.1"});
+    parser.addOption({"port", "Port nasłuchiwania (0 = dowolny wolny).", "port", "8080"});
+    parser.addOption({"stations", "Liczba stacji syntetycznych.", "n", "300"});
+    parser.addOption({"sensors", "Liczba czujników na stację.", "n", "4"});
+    parser.addOption({"hours", "Liczba godzinowych pomiarów w serii.", "n", "72"});
+    parser.addOption({"seed", "Ziarno danych i losowania błędów.", "n", "42"});
+    parser.addOption({"replay", "Odtwarza odpowiedzi nagrane w katalogu.", "dir"});
+    parser.addOption({"record", "Przekazuje żądania do upstream i nagrywa odpowiedzi do katalogu.", "dir"});
+    parser.addOption({"upstream", "Serwer nagrywany w trybie --record.", "url", "https://api.gios.gov.pl/pjp-api/rest/"});
+    parser.addOption({"latency", "Opóźnienie każdej odpowiedzi.", "ms", "0"});
+    parser.addOption({"jitter", "Losowy dodatek do opóźnienia, 0..jitter.", "ms", "0"});
+    parser.addOption({"bandwidth", "Limit przepustowości na połączenie (0 = bez limitu).", "B/s", "0"});
+    parser.addOption({"rate-429", "Udział odpowiedzi 429 Too Many Requests (0..1).", "p", "0"});
+    parser.addOption({"rate-5xx", "Udział odpowiedzi 500/502/503 (0..1).", "p", "0"});
+    parser.addOption({"truncate-rate", "Udział odpowiedzi urwanych w połowie treści (0..1).", "p", "0"});
+    parser.addOption({"stats-interval", "Co ile sekund wypisywać liczniki (0 = nigdy).", "s", "10"});
+    parser.process(app);
+
+    MockOptions options;
+    options.stations = parser.value("stations").toInt();
+    options.sensorsPerStation = parser.value("sensors").toInt();
+    options.hours = parser.value("hours").toInt();
+    options.seed = parser.value("seed").toUInt();
+    options.replayDirectory = parser.value("replay");
+    if (parser.isSet("record")) {
+        options.recordDirectory = parser.value("record");
+        options.upstream = QUrl(parser.value("upstream"));
+        QDir().mkpath(options.recordDirectory);
+    }
+    options.latencyMs = parser.value("latency").toInt();
+    options.jitterMs = parser.value("jitter").toInt();
+    options.bandwidth = parser.value("bandwidth").toLongLong();
+    options.tooManyRequestsRate = parser.value("rate-429").toDouble();
+    options.serverErrorRate = parser.value("rate-5xx").toDouble();
+    options.truncateRate = parser.value("truncate-rate").toDouble();
+
+    MockGiosServer server(options);
+    if (!server.listen(QHostAddress(parser.value("address")), quint16(parser.value("port").toUInt()))) {
+        qWarning() << "Nie można nasłuchiwać:" << server.errorString();
+        return 1;
+    }
+    out() << "Adres bazowy API: http://" << parser.value("address") << ":" << server.serverPort() << "/\n";
+    out().flush();
+
+    QTimer statsTimer;
+    const int interval = parser.value("stats-interval").toInt();
+    QObject::connect(&statsTimer, &QTimer::timeout, &server, [&server]() {
+        const MockGiosServer::Stats stats = server.stats();
+        out() << QString("żądania %1, 429: %2, 5xx: %3, urwane: %4, 404: %5, wysłano %6 KiB\n")
+                     .arg(stats.requests).arg(stats.tooManyRequests).arg(stats.serverErrors)
+                     .arg(stats.truncated).arg(stats.notFound).arg(stats.bytesSent / 1024);
+        out().flush();
+    });
+    if (interval > 0)
+        statsTimer.start(interval * 1000);
+
+    return app.exec();
+}
@@ -0,0 +1,291 @@
+#include "mockgiosserver.h"
+#include "syntheticdata.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QSaveFile>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+namespace {
+
+constexpr int TicksPerSecond = 20;              // porcje wysyłki przy ograniczonej przepustowości
+constexpr qsizetype MaxHeaderSize = 64 * 1024;  // dłuższy nagłówek żądania zamyka połączenie
+
+QByteArray reasonPhrase(int status)
+{
+    switch (status) {
+    case 200: return "OK";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    default: return "Unknown";
+    }
+}
+
+} // namespace
+
+MockGiosServer::MockGiosServer(const MockOptions &options, QObject *parent)
+    : QObject(parent),
+    m_options(options),
+    m_server(new QTcpServer(this)),
+    m_rng(options.seed)
+{
+    m_options.sensorsPerStation = qBound(1, m_options.sensorsPerStation, 99);
+    if (m_options.upstream.isValid()) {
+        m_upstream = new QNetworkAccessManager(this);
+        if (!m_options.upstream.path().endsWith('/'))
+            m_options.upstream.setPath(m_options.upstream.path() + '/');
+    } else if (m_options.replayDirectory.isEmpty()) {
+        m_stationsJson = SyntheticData::stationsJson(m_options.stations, m_options.seed);
+    }
+    connect(m_server, &QTcpServer::newConnection, this, &MockGiosServer::onNewConnection);
+}
+
+bool MockGiosServer::listen(const QHostAddress &address, quint16 port)
+{
+    return m_server->listen(address, port);
+}
+
+quint16 MockGiosServer::serverPort() const
+{
+    return m_server->serverPort();
+}
+
+QString MockGiosServer::errorString() const
+{
+    return m_server->errorString();
+}
+
+QString MockGiosServer::apiPath(const QByteArray &target)
+{
+    QString path = QUrl::fromEncoded(target).path();
+    const qsizetype rest = path.indexOf("/pjp-api/rest/");
+    if (rest >= 0)
+        path = path.mid(rest + int(qstrlen("/pjp-api/rest/")));
+    while (path.startsWith('/'))
+        path.remove(0, 1);
+    return path;
+}
+
+QString MockGiosServer::fileNameFor(const QString &path)
+{
+    QString name = path;
+    name.replace('/', '_');
+    return name + ".json";
+}
+
+void MockGiosServer::onNewConnection()
+{
+    while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+        m_connections.insert(socket, Connection());
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            m_connections[socket].buffer += socket->readAll();
+            processNext(socket);
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_connections.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MockGiosServer::processNext(QTcpSocket *socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end() || it->busy)
+        return;
+
+    const qsizetype headerEnd = it->buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        if (it->buffer.size() > MaxHeaderSize)
+            socket->disconnectFromHost();
+        return;
+    }
+    const QByteArray header = it->buffer.left(headerEnd);
+    it->buffer.remove(0, headerEnd + 4);   // żądania GET nie mają treści
+    it->busy = true;
+
+    const QList<QByteArray> lines = header.split('\n');
+    const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+    if (requestLine.size() < 3) {
+        respond(socket, 400, QByteArray(), false);
+        return;
+    }
+
+    // HTTP/1.1 domyślnie utrzymuje połączenie, HTTP/1.0 tylko na wyraźną prośbę
+    bool keepAlive = requestLine[2] == "HTTP/1.1";
+    for (qsizetype i = 1; i < lines.size(); ++i) {
+        const QByteArray line = lines[i].trimmed().toLower();
+        if (line.startsWith("connection:"))
+            keepAlive = line.contains("keep-alive");
+    }
+
+    if (requestLine[0] != "GET") {
+        respond(socket, 400, QByteArray(), keepAlive);
+        return;
+    }
+    handle(socket, apiPath(requestLine[1]), keepAlive);
+}
+
+void MockGiosServer::handle(QTcpSocket *socket, const QString &path, bool keepAlive)
+{
+    ++m_stats.requests;
+    const int delay = m_options.latencyMs + (m_options.jitterMs > 0 ? int(m_rng.bounded(m_options.jitterMs + 1)) : 0);
+    if (delay <= 0) {
+        produce(socket, path, keepAlive);
+        return;
+    }
+    QPointer<QTcpSocket> guarded(socket);
+    QTimer::singleShot(delay, this, [this, guarded, path, keepAlive]() {
+        if (guarded)
+            produce(guarded, path, keepAlive);
+    });
+}
+
+void MockGiosServer::produce(QTcpSocket *socket, const QString &path, bool keepAlive)
+{
+    // Błędy losowane są przed treścią, więc ich sekwencja nie zależy od źródła odpowiedzi
+    const double roll = m_rng.generateDouble();
+    if (roll < m_options.tooManyRequestsRate) {
+        ++m_stats.tooManyRequests;
+        respond(socket, 429, QByteArray(), keepAlive);
+        return;
+    }
+    if (roll < m_options.tooManyRequestsRate + m_options.serverErrorRate) {
+        ++m_stats.serverErrors;
+        static const int errors[] = {500, 502, 503};
+        respond(socket, errors[m_rng.bounded(3)], QByteArray(), keepAlive);
+        return;
+    }
+
+    if (m_upstream) {
+        QPointer<QTcpSocket> guarded(socket);
+        QNetworkReply *reply = m_upstream->get(QNetworkRequest(m_options.upstream.resolved(QUrl(path))));
+        connect(reply, &QNetworkReply::finished, this, [this, reply, guarded, path, keepAlive]() {
+            reply->deleteLater();
+            const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            const QByteArray body = reply->readAll();
+            if (status == 200 && !m_options.recordDirectory.isEmpty()) {
+                QSaveFile file(QDir(m_options.recordDirectory).filePath(fileNameFor(path)));
+                if (file.open(QIODevice::WriteOnly)) {
+                    file.write(body);
+                    file.commit();
+                }
+            }
+            if (guarded)
+                respond(guarded, status > 0 ? status : 502, body, keepAlive);
+        });
+        return;
+    }
+
+    int status = 200;
+    const QByteArray body = m_options.replayDirectory.isEmpty() ? synthetic(path, &status) : replay(path, &status);
+    respond(socket, status, body, keepAlive);
+}
+
+QByteArray MockGiosServer::synthetic(const QString &path, int *status) const
+{
+    const QStringList parts = path.split('/');
+    if (path == "station/findAll")
+        return m_stationsJson;
+
+    bool ok = false;
+    const int id = parts.value(2).toInt(&ok);
+    if (ok && parts.size() == 3 && parts[0] == "station" && parts[1] == "sensors") {
+        if (id >= 100 && id < 100 + m_options.stations)
+            return SyntheticData::sensorsJson(id, m_options.sensorsPerStation);
+        return "[]";
+    }
+    if (ok && parts.size() == 3 && parts[0] == "data" && parts[1] == "getData") {
+        const int stationId = id / 100;
+        const int index = id % 100;
+        if (stationId >= 100 && stationId < 100 + m_options.stations && index < m_options.sensorsPerStation) {
+            // Seria kończy się na bieżącej pełnej godzinie, więc kolejne odpytania dopisują nowe pomiary
+            const qint64 hour = 3600 * 1000;
+            const qint64 start = QDateTime::currentMSecsSinceEpoch() / hour * hour - qint64(m_options.hours - 1) * hour;
+            return SyntheticData::measurementsJson(SyntheticData::paramCode(index), m_options.hours,
+                                                   m_options.seed ^ quint32(id), start);
+        }
+    }
+
+    *status = 404;
+    return QByteArray();
+}
+
+QByteArray MockGiosServer::replay(const QString &path, int *status)
+{
+    auto it = m_replayCache.constFind(path);
+    if (it != m_replayCache.cend())
+        return *it;
+
+    QFile file(QDir(m_options.replayDirectory).filePath(fileNameFor(path)));
+    if (!file.open(QIODevice::ReadOnly)) {
+        *status = 404;
+        return QByteArray();
+    }
+    const QByteArray body = file.readAll();
+    m_replayCache.insert(path, body);
+    return body;
+}
+
+void MockGiosServer::respond(QTcpSocket *socket, int status, const QByteArray &body, bool keepAlive)
+{
+    if (status == 404)
+        ++m_stats.notFound;
+
+    QByteArray response = "HTTP/1.1 " + QByteArray::number(status) + ' ' + reasonPhrase(status) + "\r\n";
+    response += "Content-Type: application/json;charset=UTF-8\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    if (status == 429)
+        response += "Retry-After: 1\r\n";
+    response += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    response += "\r\n";
+    const qsizetype headerSize = response.size();
+    response += body;
+
+    // Urwana odpowiedź: nagłówek zapowiada całą treść, a połączenie zamyka się w połowie
+    qsizetype limit = response.size();
+    bool close = !keepAlive;
+    if (status == 200 && !body.isEmpty() && m_rng.generateDouble() < m_options.truncateRate) {
+        ++m_stats.truncated;
+        limit = headerSize + body.size() / 2;
+        close = true;
+    }
+    sendChunks(socket, response, 0, limit, close);
+}
+
+void MockGiosServer::sendChunks(QPointer<QTcpSocket> socket, const QByteArray &data, qsizetype offset,
+                                qsizetype limit, bool close)
+{
+    if (!socket)
+        return;
+
+    const qsizetype chunk = m_options.bandwidth > 0 ? qMax<qint64>(1, m_options.bandwidth / TicksPerSecond)
+                                                    : limit - offset;
+    const qsizetype count = qMin(chunk, limit - offset);
+    socket->write(data.constData() + offset, count);
+    m_stats.bytesSent += count;
+    offset += count;
+
+    if (offset < limit) {
+        QTimer::singleShot(1000 / TicksPerSecond, this, [=]() { sendChunks(socket, data, offset, limit, close); });
+        return;
+    }
+
+    if (close) {
+        socket->disconnectFromHost();
+        return;
+    }
+    auto it = m_connections.find(socket.data());
+    if (it == m_connections.end())
+        return;
+    it->busy = false;
+    processNext(socket);
+}
@@ -0,0 +1,108 @@
+#ifndef MOCKGIOSSERVER_H
+#define MOCKGIOSSERVER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QObject>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QString>
+#include <QUrl>
+
+class QNetworkAccessManager;
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @brief Konfiguracja lokalnego serwera zastępującego API GIOŚ.
+ */
+struct MockOptions
+{
+    // Źródło odpowiedzi: nagrywanie z upstream, odtwarzanie z katalogu albo dane syntetyczne
+    QUrl upstream;                  ///< Serwer, którego odpowiedzi są przekazywane i nagrywane.
+    QString recordDirectory;        ///< Katalog zapisu nagrywanych odpowiedzi.
+    QString replayDirectory;        ///< Katalog odtwarzanych odpowiedzi (brak pliku = 404).
+
+    int stations = 300;             ///< Liczba stacji syntetycznych.
+    int sensorsPerStation = 4;      ///< Liczba czujników na stację (co najwyżej 99).
+    int hours = 72;                 ///< Liczba godzinowych pomiarów w serii, kończących się na bieżącej godzinie.
+    quint32 seed = 42;              ///< Ziarno danych i losowania błędów.
+
+    // Wstrzykiwanie opóźnień i błędów
+    int latencyMs = 0;              ///< Stałe opóźnienie odpowiedzi.
+    int jitterMs = 0;               ///< Losowy dodatek do opóźnienia, 0..jitterMs.
+    qint64 bandwidth = 0;           ///< Limit przepustowości na połączenie w B/s (0 = bez limitu).
+    double tooManyRequestsRate = 0.0;   ///< Udział odpowiedzi 429.
+    double serverErrorRate = 0.0;       ///< Udział odpowiedzi 500/502/503.
+    double truncateRate = 0.0;          ///< Udział odpowiedzi urwanych w połowie treści.
+};
+
+/**
+ * @brief Lokalny serwer HTTP/1.1 z endpointami station/findAll, station/sensors/<id> i data/getData/<id>.
+ * @details Pozwala mierzyć przepustowość i opóźnienia pobierania bez dostępu do sieci, w powtarzalnych
+ * warunkach: te same opcje i ziarno dają te same dane i tę samą sekwencję błędów dla kolejnych żądań.
+ * Obsługuje połączenia keep-alive; żądania na jednym połączeniu są obsługiwane po kolei.
+ */
+class MockGiosServer : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Liczniki obsłużonych żądań.
+     */
+    struct Stats
+    {
+        qint64 requests = 0;
+        qint64 tooManyRequests = 0;
+        qint64 serverErrors = 0;
+        qint64 truncated = 0;
+        qint64 notFound = 0;
+        qint64 bytesSent = 0;
+    };
+
+    explicit MockGiosServer(const MockOptions &options, QObject *parent = nullptr);
+
+    bool listen(const QHostAddress &address = QHostAddress::LocalHost, quint16 port = 0);
+    quint16 serverPort() const;
+    QString errorString() const;
+    Stats stats() const { return m_stats; }
+
+    /**
+     * @brief Ścieżka endpointu względem adresu bazowego API, np. "station/sensors/114".
+     * @details Akceptuje też pełną ścieżkę serwera GIOŚ (/pjp-api/rest/...) i pomija parametry zapytania.
+     */
+    static QString apiPath(const QByteArray &target);
+    /**
+     * @brief Nazwa pliku nagrania dla ścieżki endpointu, np. "station_sensors_114.json".
+     */
+    static QString fileNameFor(const QString &path);
+
+private:
+    struct Connection
+    {
+        QByteArray buffer;      ///< Odebrane, jeszcze nieobsłużone bajty.
+        bool busy = false;      ///< Trwa obsługa żądania (opóźnienie lub wysyłanie).
+    };
+
+    void onNewConnection();
+    void processNext(QTcpSocket *socket);
+    void handle(QTcpSocket *socket, const QString &path, bool keepAlive);
+    void produce(QTcpSocket *socket, const QString &path, bool keepAlive);
+    QByteArray synthetic(const QString &path, int *status) const;
+    QByteArray replay(const QString &path, int *status);
+    void respond(QTcpSocket *socket, int status, const QByteArray &body, bool keepAlive);
+    void sendChunks(QPointer<QTcpSocket> socket, const QByteArray &data, qsizetype offset, qsizetype limit,
+                    bool close);
+
+    MockOptions m_options;
+    QTcpServer *m_server;
+    QNetworkAccessManager *m_upstream = nullptr;
+    QHash<QTcpSocket *, Connection> m_connections;
+    QHash<QString, QByteArray> m_replayCache;
+    QByteArray m_stationsJson;
+    QRandomGenerator m_rng;
+    Stats m_stats;
+};
+
+#endif // MOCKGIOSSERVER_H
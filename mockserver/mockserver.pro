@@ -0,0 +1,20 @@
+QT       = core network
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+TARGET = pogoda-mockserver
+
+include(../core/core.pri)
+
+# Dane syntetyczne wspólne z benchmarkami
+INCLUDEPATH += $$PWD/../benchmarks
+DEPENDPATH += $$PWD/../benchmarks
+
+SOURCES += \
+    ../benchmarks/syntheticdata.cpp \
+    main.cpp \
+    mockgiosserver.cpp
+
+HEADERS += \
+    ../benchmarks/syntheticdata.h \
+    mockgiosserver.h
@@ -0,0 +1,1347 @@
+#include <QtTest>
+#include <QApplication>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QListWidget>
+#include <QMessageBox>
+#include <QTimer>
+#include <QFile>
+#include <QTextStream>
+#include <memory>
+#include "mainwindow.h"
+#include "apimanager.h"
+#include "giosparser.h"
+#include "seriesstore.h"
+#include "apicache.h"
+#include "measurementarchive.h"
+#include "bulkcrawler.h"
+#include "statkernels.h"
+#include "runningaggregate.h"
+#include "seriesrollup.h"
+#include "downsample.h"
+#include "dateparser.h"
+#include "stationsearch.h"
+#include "stationgeoindex.h"
+#include "regionreport.h"
+#include "seriesexport.h"
+#include "chartrenderer.h"
+#include "tracer.h"
+#include "asyncwriter.h"
+#include "stationsnapshot.h"
+#include "mockgiosserver.h"
+#include "syntheticdata.h"
+
+/**
+ * @brief Klasa testująca funkcjonalności ApiManager oraz MainWindow.
+ */
+class TestApiManager : public QObject {
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Inicjalizacja przed każdym testem.
+     */
+    void initTestCase() {
+        // Osobna, pusta pamięć podręczna HTTP: odpowiedzi z poprzednich przebiegów (ten sam port
+        // serwera testowego) nie mogą zastąpić żądań, które test wysyła do sieci
+        QStandardPaths::setTestModeEnabled(true);
+        QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/http").removeRecursively();
+        // Migawka katalogu stacji trafia do katalogu roboczego - testy nie mogą nadpisać
+        // katalogu użytkownika, więc pracują w katalogu tymczasowym
+        QVERIFY(m_workDir.isValid());
+        m_originalDir = QDir::currentPath();
+        QVERIFY(QDir::setCurrent(m_workDir.path()));
+    }
+
+    /**
+     * @brief Sprzątanie po każdym teście.
+     */
+    void cleanupTestCase() {
+        // Zapisy w tle muszą się zakończyć, zanim katalog tymczasowy zostanie usunięty
+        AsyncWriter::instance().flush();
+        QDir::setCurrent(m_originalDir);
+    }
+
+    /**
+     * @brief Testuje parsowanie poprawnego JSON z listą stacji.
+     */
+    void testParseJson() {
+        QString json = "[{\"stationName\": \"Test Station\", \"id\": 1}]";
+        QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
+        QVERIFY(doc.isArray());
+        QCOMPARE(doc.array().size(), 1);
+        QCOMPARE(doc.array()[0].toObject()["stationName"].toString(), "Test Station");
+    }
+
+    /**
+     * @brief Testuje parsowanie nieprawidłowego JSON.
+     */
+    void testParseInvalidJson() {
+        QString json = "{invalid}";
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8(), &parseError);
+        QVERIFY(parseError.error != QJsonParseError::NoError);
+    }
+
+    /**
+     * @brief Testuje parsowanie danych pomiarowych.
+     */
+    void testParseMeasurementJson() {
+        QString json = "{\"key\": \"PM10\", \"values\": [{\"date\": \"2023-10-01\", \"value\": 25.0}]}";
+        QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
+        QVERIFY(doc.isObject());
+        QJsonObject obj = doc.object();
+        QCOMPARE(obj["key"].toString(), "PM10");
+        QJsonArray values = obj["values"].toArray();
+        QCOMPARE(values.size(), 1);
+        QCOMPARE(values[0].toObject()["value"].toDouble(), 25.0);
+    }
+
+    /**
+     * @brief Testuje dekodowanie danych pomiarowych z wartościami null.
+     */
+    void testGiosParserMeasurements() {
+        QByteArray json = R"({"key": "PM10", "values": [
+            {"date": "2023-10-01 12:00:00", "value": 25.5},
+            {"date": "2023-10-01 11:00:00", "value": null}
+        ]})";
+        MeasurementSeries series;
+        QVERIFY(GiosParser::parseMeasurements(json, series));
+        QCOMPARE(series.paramCode, QString("PM10"));
+        QCOMPARE(series.values.size(), 2);
+        QVERIFY(series.values[0].valid);
+        QCOMPARE(series.values[0].value, 25.5);
+        QVERIFY(!series.values[1].valid);
+
+        QList<Station> stations;
+        QVERIFY(!GiosParser::parseStations(json, stations));
+    }
+
+    /**
+     * @brief Testuje magazyn kolumnowy: sortowanie po czasie i bitmapę ważności.
+     */
+    void testSeriesStoreColumns() {
+        MeasurementSeries series;
+        series.paramCode = "PM10";
+        series.values = {
+            {"2023-10-01 12:00:00", 30.0, true},
+            {"2023-10-01 11:00:00", 0.0, false},
+            {"2023-10-01 10:00:00", 20.0, true}
+        };
+
+        SeriesStore store;
+        store.ingest(7, series);
+        QVERIFY(store.contains(SeriesKey{7, "PM10"}));
+        QVERIFY(!store.contains(SeriesKey{8, "PM10"}));
+
+        SeriesColumns columns = store.series(SeriesKey{7, "PM10"});
+        QCOMPARE(columns.size(), 3);
+        QVERIFY(columns.timestamp(0) < columns.timestamp(1));
+        QVERIFY(columns.timestamp(1) < columns.timestamp(2));
+        QCOMPARE(columns.value(0), 20.0f);
+        QVERIFY(columns.isValid(0));
+        QVERIFY(!columns.isValid(1));
+        QCOMPARE(columns.value(2), 30.0f);
+
+        store.removeStation(7);
+        QVERIFY(!store.contains(SeriesKey{7, "PM10"}));
+
+        // Powtórzona godzina daje jeden pomiar z ostatnim ważnym odczytem
+        const QList<MeasurementPoint> repeated = {
+            {"2023-10-01 12:00:00", 30.0, true},
+            {"2023-10-01 11:00:00", 25.0, true},
+            {"2023-10-01 11:00:00", 27.0, true},
+            {"2023-10-01 11:00:00", 0.0, false},
+            {"2023-10-01 10:00:00", 20.0, true}
+        };
+        const SeriesColumns deduplicated = SeriesStore::columnsFromPoints(repeated);
+        QCOMPARE(deduplicated.size(), qsizetype(3));
+        QVERIFY(deduplicated.timestamp(0) < deduplicated.timestamp(1));
+        QVERIFY(deduplicated.timestamp(1) < deduplicated.timestamp(2));
+        QVERIFY(deduplicated.isValid(1));
+        QCOMPARE(deduplicated.value(1), 27.0f);
+        store.insert(SeriesKey{7, "PM10"}, deduplicated);
+        QCOMPARE(store.aggregate(SeriesKey{7, "PM10"}).count(), qint64(3));
+    }
+
+    /**
+     * @brief Testuje kolejkę żądań ApiManager: limit jednoczesnych żądań, priorytety i anulowanie.
+     */
+    void testRequestScheduler() {
+        MockOptions options;
+        options.stations = 5;
+        options.sensorsPerStation = 1;
+        options.latencyMs = 50;
+        MockGiosServer server(options);
+        QVERIFY(server.listen());
+        ApiManager api;
+        api.setBaseUrl(mockBaseUrl(server));
+        api.setMaxInFlight(1);
+
+        QList<int> order;
+        int measurements = 0;
+        int failures = 0;
+        int maxInFlight = 0;
+        connect(&api, &ApiManager::sensorsReceived, this, [&](int stationId, const QList<Sensor> &) {
+            order << stationId;
+            maxInFlight = qMax(maxInFlight, api.inFlightCount());
+        });
+        connect(&api, &ApiManager::measurementsReceived, this, [&](const MeasurementSeries &) {
+            ++measurements;
+            maxInFlight = qMax(maxInFlight, api.inFlightCount());
+        });
+        connect(&api, &ApiManager::requestFailed, this, [&]() {
+            ++failures;
+        });
+
+        // Wstrzymana kolejka: żądania czekają i można je anulować, zanim cokolwiek wyjdzie do sieci
+        api.setPaused(true);
+        api.getSensorsForStation(100, RequestPriority::Bulk);
+        api.getSensorsForStation(101, RequestPriority::Refresh);
+        api.getSensorsForStation(102, RequestPriority::Interactive);
+        api.getSensorsForStation(103, RequestPriority::Interactive);
+        QCOMPARE(api.pendingCount(), 4);
+        QCOMPARE(api.inFlightCount(), 0);
+        api.cancelStation(103);
+        QCOMPARE(api.pendingCount(), 3);
+
+        // Po wznowieniu żądania wychodzą po jednym, od najwyższego priorytetu
+        api.setPaused(false);
+        QCOMPARE(api.inFlightCount(), 1);
+        QTRY_COMPARE(measurements, 3);
+        QCOMPARE(order, (QList<int>{102, 101, 100}));
+        QVERIFY(maxInFlight <= 1);
+        QCOMPARE(api.pendingCount(), 0);
+
+        // Anulowanie trwającego żądania nie zgłasza ani wyniku, ani błędu
+        api.getSensorsForStation(104);
+        QCOMPARE(api.inFlightCount(), 1);
+        api.cancelStation(104);
+        QCOMPARE(api.inFlightCount(), 0);
+        QTest::qWait(2 * options.latencyMs);
+        QCOMPARE(order.size(), 3);
+        QCOMPARE(failures, 0);
+    }
+
+    /**
+     * @brief Testuje czasy ważności wpisów cache dla poszczególnych endpointów.
+     */
+    void testApiCacheExpiration() {
+        const QDateTime now(QDate(2023, 10, 1), QTime(12, 34, 56), QTimeZone::UTC);
+        const QString base = "https://api.gios.gov.pl/pjp-api/rest/";
+
+        QCOMPARE(ApiCache::expirationFor(QUrl(base + "data/getData/92"), now),
+                 QDateTime(QDate(2023, 10, 1), QTime(13, 0), QTimeZone::UTC));
+        QCOMPARE(ApiCache::expirationFor(QUrl(base + "station/findAll"), now), now.addDays(1));
+        QCOMPARE(ApiCache::expirationFor(QUrl(base + "station/sensors/14"), now), now.addDays(1));
+    }
+
+    /**
+     * @brief Testuje archiwum: dopisywanie, deduplikację, korekty, kompakcję i odczyt zakresu.
+     */
+    void testMeasurementArchive() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        MeasurementArchive archive(dir.path());
+        const SeriesKey key{5, "PM2.5"};
+        const qint64 hour = 3600 * 1000;
+
+        SeriesColumns first;
+        first.append(0 * hour, 10.0f, true);
+        first.append(1 * hour, 0.0f, false);
+        first.append(2 * hour, 12.0f, true);
+        MeasurementArchive::IngestStats stats = archive.ingest(key, first);
+        QCOMPARE(stats.appended, 3);
+
+        // Nakładające się godziny: jedna bez zmian, jedna uzupełniona, jedna nowa
+        SeriesColumns second;
+        second.append(0 * hour, 10.0f, true);
+        second.append(1 * hour, 11.0f, true);
+        second.append(3 * hour, 13.0f, true);
+        stats = archive.ingest(key, second);
+        QCOMPARE(stats.duplicates, 1);
+        QCOMPARE(stats.corrected, 1);
+        QCOMPARE(stats.appended, 1);
+        QVERIFY(stats.ok());
+
+        // Korekta jest od razu scalana, więc kolejne godziny znów trafiają do prefiksu
+        {
+            ArchiveSegment segment(archive.pathFor(key));
+            QVERIFY(segment.open());
+            QCOMPARE(segment.sortedCount(), segment.size());
+            QCOMPARE(segment.size(), qsizetype(4));
+        }
+
+        SeriesColumns all = archive.read(key);
+        QCOMPARE(all.size(), 4);
+        QVERIFY(all.isValid(1));
+        QCOMPARE(all.value(1), 11.0f);
+        QCOMPARE(all.timestamp(3), 3 * hour);
+
+        QVERIFY(archive.compact(key));
+        SeriesColumns window = archive.read(key, 1 * hour, 2 * hour);
+        QCOMPARE(window.size(), 2);
+        QCOMPARE(window.value(0), 11.0f);
+        QCOMPARE(window.value(1), 12.0f);
+
+        QCOMPARE(archive.keys().size(), 1);
+        QCOMPARE(archive.keys().first(), key);
+
+        // Segment, którego nie da się odczytać, nie jest nadpisywany pustym
+        const SeriesKey foreignKey{6, "NO2"};
+        QFile foreign(archive.pathFor(foreignKey));
+        QVERIFY(foreign.open(QIODevice::WriteOnly));
+        const QByteArray foreignData(64, 'x');
+        foreign.write(foreignData);
+        foreign.close();
+        stats = archive.ingest(foreignKey, first);
+        QVERIFY(!stats.ok());
+        QCOMPARE(stats.appended, 0);
+        QVERIFY(foreign.open(QIODevice::ReadOnly));
+        QCOMPARE(foreign.readAll(), foreignData);
+        foreign.close();
+    }
+
+    /**
+     * @brief Testuje liczniki postępu BulkCrawler i zapis odebranych serii do archiwum.
+     * @details Odpowiedzi są podawane sygnałami ApiManager, a żądania wysłane przez crawler
+     * anulowane od razu, więc test nie zależy od sieci.
+     */
+    void testBulkCrawlerStats() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        ApiManager api;
+        MeasurementArchive archive(dir.path());
+        BulkCrawler crawler(&api, &archive);
+        crawler.setConcurrency(2);
+        bool finished = false;
+        BulkCrawler::Stats result;
+        connect(&crawler, &BulkCrawler::finished, this, [&](const BulkCrawler::Stats &stats) {
+            result = stats;
+            finished = true;
+        });
+
+        crawler.start();
+        QVERIFY(crawler.isRunning());
+        QCOMPARE(api.maxInFlight(), 2);
+        api.cancelStation(0);
+
+        Station first;
+        first.id = 100;
+        Station second;
+        second.id = 101;
+        emit api.stationsReceived({first, second});
+        api.cancelStation(100);
+        api.cancelStation(101);
+        QCOMPARE(crawler.stats().stations, 2);
+
+        Sensor pm10;
+        pm10.id = 1001;
+        pm10.stationId = 100;
+        pm10.paramCode = "PM10";
+        Sensor no2;
+        no2.id = 1011;
+        no2.stationId = 101;
+        no2.paramCode = "NO2";
+        emit api.sensorsReceived(100, {pm10});
+        emit api.sensorsReceived(101, {no2});
+        QCOMPARE(crawler.stats().sensorsTotal, 2);
+
+        MeasurementSeries series;
+        series.stationId = 100;
+        series.sensorId = 1001;
+        series.paramCode = "PM10";
+        series.values = {
+            {"2024-01-01 03:00:00", 30.0, true},
+            {"2024-01-01 02:00:00", 0.0, false},
+            {"2024-01-01 01:00:00", 20.0, true}
+        };
+        emit api.measurementsReceived(series);
+        QVERIFY(!finished);
+
+        // Nieudane żądanie też zamyka czujnik - po nim pobieranie jest zakończone
+        emit api.requestFailed(RequestKind::Data, 101, 1011, "Przekroczono czas");
+        QVERIFY(finished);
+        QVERIFY(!crawler.isRunning());
+        QCOMPARE(result.stations, 2);
+        QCOMPARE(result.sensorListsDone, 2);
+        QCOMPARE(result.sensorsDone, 2);
+        QCOMPARE(result.failures, 1);
+        QCOMPARE(result.requests, qint64(1 + 2 + 2));
+        QCOMPARE(result.points, qint64(2));
+
+        const QList<SeriesKey> keys = archive.keys();
+        QCOMPARE(keys.size(), 1);
+        QVERIFY(keys.first() == (SeriesKey{100, "PM10"}));
+        QVERIFY(!archive.read(keys.first()).isEmpty());
+    }
+
+    /**
+     * @brief Testuje asynchroniczną analizę: wyniki zgodne z analizą synchroniczną i anulowanie.
+     */
+    void testAnalysisService() {
+        const qint64 hour = 3600 * 1000;
+        auto makeSeries = [hour](int size, int seed) {
+            SeriesColumns series;
+            series.reserve(size);
+            for (int i = 0; i < size; ++i) {
+                series.append(i * hour, float((i * 7 + seed * 13) % 60), i % 17 != 0);
+            }
+            return series;
+        };
+
+        AnalysisService service;
+        QList<AnalysisService::Job> jobs;
+        jobs << AnalysisService::Job{"PM10", makeSeries(2000, 1)}
+             << AnalysisService::Job{"NO2", makeSeries(2000, 2)};
+
+        QMap<int, AnalysisResult> results;
+        int finishedCount = 0;
+        bool cancelled = false;
+        connect(&service, &AnalysisService::resultReady, this, [&](int index, const AnalysisResult &result) {
+            results.insert(index, result);
+        });
+        connect(&service, &AnalysisService::finished, this, [&](bool wasCancelled) {
+            ++finishedCount;
+            cancelled = wasCancelled;
+        });
+
+        service.start(jobs);
+        QTRY_COMPARE(finishedCount, 1);
+        QVERIFY(!cancelled);
+        QCOMPARE(results.size(), 2);
+        for (int i = 0; i < jobs.size(); ++i) {
+            const AnalysisResult expected = SeriesAnalysis::analyze(jobs[i].paramCode, jobs[i].series);
+            QCOMPARE(results[i].paramCode, expected.paramCode);
+            QCOMPARE(results[i].count, expected.count);
+            QCOMPARE(results[i].exceedances, expected.exceedances);
+            QVERIFY(qAbs(results[i].mean - expected.mean) < 1e-9);
+        }
+
+        // Dużo zadań na współdzielonej serii - anulowanie zdąży przed końcem
+        QList<AnalysisService::Job> many;
+        const SeriesColumns large = makeSeries(200000, 3);
+        for (int i = 0; i < 500; ++i) {
+            many << AnalysisService::Job{"PM10", large};
+        }
+        results.clear();
+        service.start(many);
+        service.cancel();
+        QTRY_COMPARE(finishedCount, 2);
+        QVERIFY(cancelled);
+        QVERIFY(results.size() < many.size());
+        QVERIFY(!service.isRunning());
+    }
+
+    /**
+     * @brief Testuje zgodność wektorowych jąder statystyk z wersją skalarną.
+     */
+    void testStatKernelsMatchScalar() {
+        SeriesColumns series;
+        for (int i = 0; i < 1003; ++i) {
+            series.append(qint64(i) * 3600 * 1000, float((i * 37) % 61), i % 7 != 0);
+        }
+
+        const SeriesMoments reference = StatKernels::computeWith(StatKernels::Isa::Scalar, series.timestamps(),
+                                                                 series.values(), series.validity(), 5, 1001, 0, 25.0f);
+        for (StatKernels::Isa isa : StatKernels::availableIsas()) {
+            const SeriesMoments m = StatKernels::computeWith(isa, series.timestamps(), series.values(),
+                                                             series.validity(), 5, 1001, 0, 25.0f);
+            QCOMPARE(m.count, reference.count);
+            QCOMPARE(m.exceedances, reference.exceedances);
+            QCOMPARE(m.min, reference.min);
+            QCOMPARE(m.max, reference.max);
+            QVERIFY(qAbs(m.sum - reference.sum) < 1e-6 * qAbs(reference.sum));
+            QVERIFY(qAbs(m.sumXY - reference.sumXY) < 1e-6 * qAbs(reference.sumXY));
+            QVERIFY(qAbs(m.slope() - reference.slope()) < 1e-9);
+        }
+    }
+
+    /**
+     * @brief Zakres kończący się na granicy słowa bitmapy: jądra nie mogą czytać słowa za bitmapą.
+     * @details Bitmapa ma dokładnie tyle słów, ile potrzeba, więc odczyt za nią wykrywa AddressSanitizer.
+     */
+    void testStatKernelsWordBoundary() {
+        for (const int size : {64, 128}) {
+            SeriesColumns series;
+            for (int i = 0; i < size; ++i) {
+                series.append(qint64(i) * 3600 * 1000, float(i % 13), i % 5 != 0);
+            }
+            const qsizetype words = size / 64;
+            std::unique_ptr<quint64[]> validity(new quint64[words]);
+            std::copy(series.validity(), series.validity() + words, validity.get());
+
+            const SeriesMoments reference = StatKernels::computeWith(StatKernels::Isa::Scalar, series.timestamps(),
+                                                                     series.values(), validity.get(), 0, size, 0);
+            for (StatKernels::Isa isa : StatKernels::availableIsas()) {
+                const SeriesMoments m = StatKernels::computeWith(isa, series.timestamps(), series.values(),
+                                                                 validity.get(), 0, size, 0);
+                QCOMPARE(m.count, reference.count);
+                QCOMPARE(m.min, reference.min);
+                QCOMPARE(m.max, reference.max);
+                QVERIFY(qAbs(m.sum - reference.sum) < 1e-6 * qAbs(reference.sum));
+            }
+        }
+    }
+
+    /**
+     * @brief Sprawdza, że scalone agregaty i przyrostowe dopisywanie dają wynik pełnego przebiegu.
+     */
+    void testRunningAggregateMerge() {
+        const qint64 origin = QDateTime(QDate(2025, 1, 1), QTime(0, 0), QTimeZone::UTC).toMSecsSinceEpoch();
+        SeriesColumns first, second, all;
+        RunningAggregate left(25.0f), right(25.0f);
+        for (int i = 0; i < 500; ++i) {
+            const qint64 ts = origin + qint64(i) * 3600 * 1000;
+            const float value = float((i * 37) % 61);
+            (i < 300 ? first : second).append(ts, value, true);
+            all.append(ts, value, true);
+            (i < 300 ? left : right).add(ts, value);
+        }
+        left.merge(right);
+
+        const RunningAggregate full = RunningAggregate::fromColumns(all, 25.0f);
+        QCOMPARE(left.count(), full.count());
+        QCOMPARE(left.exceedances(), full.exceedances());
+        QCOMPARE(left.max(), full.max());
+        QVERIFY(qAbs(left.mean() - full.mean()) < 1e-9);
+        QVERIFY(qAbs(left.variance() - full.variance()) < 1e-6);
+        QVERIFY(qAbs(left.slope() - full.slope()) < 1e-9);
+
+        SeriesStore store;
+        const SeriesKey key{1, "PM10"};
+        store.insert(key, first);
+        const SeriesStore::MergeResult merged = store.merge(key, second);
+        QCOMPARE(merged.appended, second.size());
+        QCOMPARE(merged.corrected, qsizetype(0));
+        QCOMPARE(store.aggregate(key).count(), full.count());
+        QVERIFY(qAbs(store.aggregate(key).slope() - full.slope()) < 1e-9);
+
+        SeriesColumns correction;
+        correction.append(origin, 99.0f, true);
+        QCOMPARE(store.merge(key, correction).corrected, qsizetype(1));
+        QCOMPARE(store.series(key).value(0), 99.0f);
+        QCOMPARE(store.aggregate(key).max(), 99.0f);
+    }
+
+    /**
+     * @brief Testuje agregaty dobowe i miesięczne oraz wybór poziomu zapytania.
+     */
+    void testSeriesRollup() {
+        const qint64 origin = QDate(2025, 1, 1).startOfDay().toMSecsSinceEpoch();
+        const qint64 hour = 3600 * 1000;
+        SeriesColumns columns;
+        for (int i = 0; i < 24 * 60; ++i) {
+            columns.append(origin + i * hour, float(i % 24), true);
+        }
+
+        SeriesStore store;
+        const SeriesKey key{1, "NO2"};
+        store.insert(key, SeriesColumns());
+        for (qsizetype i = 0; i < columns.size(); ++i) {
+            SeriesColumns update;
+            update.append(columns.timestamp(i), columns.value(i), true);
+            store.merge(key, update);
+        }
+
+        const qint64 end = origin + 24 * 60 * hour - 1;
+        const RollupQuery week = store.query(key, origin, origin + 7 * 24 * hour, 800);
+        QCOMPARE(week.level, RollupLevel::Raw);
+
+        const RollupQuery daily = store.query(key, origin, end, 800);
+        QCOMPARE(daily.level, RollupLevel::Daily);
+        QCOMPARE(daily.buckets.size(), 60);
+        QCOMPARE(daily.buckets.first().count, 24);
+        QCOMPARE(daily.buckets.first().min, 0.0f);
+        QCOMPARE(daily.buckets.first().max, 23.0f);
+        QCOMPARE(daily.buckets.first().mean(), 11.5);
+
+        const RollupQuery monthly = store.query(key, origin, end, 40);
+        QCOMPARE(monthly.level, RollupLevel::Monthly);
+        QCOMPARE(monthly.buckets.size(), 2);
+        QCOMPARE(monthly.buckets.first().count, 31 * 24);
+    }
+
+    /**
+     * @brief Testuje decymację LTTB: liczbę punktów, krańce i zachowanie szczytu.
+     */
+    void testDownsampleLttb() {
+        QList<QPointF> points;
+        for (int i = 0; i < 10000; ++i) {
+            points.append(QPointF(i, i == 4321 ? 500.0 : (i % 50)));
+        }
+
+        const QList<QPointF> sampled = Downsample::lttb(points, 800);
+        QCOMPARE(sampled.size(), qsizetype(800));
+        QCOMPARE(sampled.first(), points.first());
+        QCOMPARE(sampled.last(), points.last());
+        QVERIFY(sampled.contains(QPointF(4321, 500.0)));
+        QCOMPARE(Downsample::lttb(points.mid(0, 100), 800).size(), qsizetype(100));
+    }
+
+    /**
+     * @brief Porównuje szybki parser dat z QDateTime, także w dniach zmiany czasu.
+     */
+    void testDateParser() {
+        DateParser parser;
+        QDateTime dt(QDate(2024, 3, 29), QTime(0, 0));
+        for (int i = 0; i < 24 * 10; ++i, dt = dt.addSecs(3600)) {
+            const QString text = dt.toString("yyyy-MM-dd HH:mm:ss");
+            qint64 ms = 0;
+            QVERIFY(parser.parse(text, &ms));
+            QCOMPARE(ms, QDateTime::fromString(text, "yyyy-MM-dd HH:mm:ss").toMSecsSinceEpoch());
+        }
+
+        qint64 ms = 0;
+        QVERIFY(!parser.parse(u"2024-02-30 10:00:00", &ms));
+        QVERIFY(!parser.parse(u"2024-01-01", &ms));
+        QVERIFY(!parser.parse(u"2024/01/01 10:00:00", &ms));
+        QVERIFY(!parser.parse(u"2024-01-01T10:00:00Z", &ms));
+        QVERIFY(!parser.parse(u"2024-01-01T10:00:00+02:00", &ms));
+        QVERIFY(!parser.parse(u"2024-01-01 10:00:00.123", &ms));
+
+        // Daty spoza stałego formatu przechodzą przez QDateTime, nieczytelne są pomijane
+        QList<MeasurementPoint> points;
+        points << MeasurementPoint{"2024-01-02", 2.0, true}
+               << MeasurementPoint{"2024-01-01T10:00:00", 1.0, true}
+               << MeasurementPoint{"2024-01-03T10:00:00Z", 4.0, true}
+               << MeasurementPoint{"2024-01-04T12:00:00+02:00", 5.0, true}
+               << MeasurementPoint{"wczoraj", 3.0, true};
+        const SeriesColumns parsed = SeriesStore::columnsFromPoints(points);
+        QCOMPARE(parsed.size(), qsizetype(4));
+        QCOMPARE(parsed.timestamp(0), QDateTime(QDate(2024, 1, 1), QTime(10, 0)).toMSecsSinceEpoch());
+        QCOMPARE(parsed.timestamp(1), QDateTime(QDate(2024, 1, 2), QTime(0, 0)).toMSecsSinceEpoch());
+        QCOMPARE(parsed.timestamp(2), QDateTime(QDate(2024, 1, 3), QTime(10, 0), QTimeZone::UTC).toMSecsSinceEpoch());
+        QCOMPARE(parsed.timestamp(3), QDateTime(QDate(2024, 1, 4), QTime(10, 0), QTimeZone::UTC).toMSecsSinceEpoch());
+
+        SeriesColumns columns;
+        for (int i = 0; i < 100; ++i) {
+            columns.append(i * 10, float(i), true);
+        }
+        const SeriesSlice slice = columns.slice(95, 200);
+        QCOMPARE(slice.begin, qsizetype(10));
+        QCOMPARE(slice.end, qsizetype(21));
+        QCOMPARE(slice.columns.timestamps(), columns.timestamps());
+        QVERIFY(columns.slice(2000, 3000).isEmpty());
+    }
+
+    /**
+     * @brief Sprawdza, że magazyn zgłasza dopisane pomiary osobno od przebudowy serii.
+     */
+    void testSeriesStoreSignals() {
+        SeriesStore store;
+        QSignalSpy appended(&store, &SeriesStore::seriesAppended);
+        QSignalSpy reset(&store, &SeriesStore::seriesReset);
+        const SeriesKey key{3, "O3"};
+
+        SeriesColumns first;
+        first.append(1000, 1.0f, true);
+        store.insert(key, first);
+        QCOMPARE(reset.count(), 1);
+
+        SeriesColumns update;
+        update.append(1000, 1.0f, true);
+        update.append(2000, 2.0f, true);
+        update.append(3000, 3.0f, true);
+        store.merge(key, update);
+        QCOMPARE(appended.count(), 1);
+        QCOMPARE(appended.first().at(1).value<qsizetype>(), qsizetype(2));
+        QCOMPARE(reset.count(), 1);
+
+        store.removeStation(3);
+        QCOMPARE(reset.count(), 2);
+    }
+
+    /**
+     * @brief Testuje okno wykresu: dopisywanie nowych pomiarów z magazynu i odłączenie po zamknięciu.
+     */
+    void testChartWindowIncremental() {
+        SeriesStore store;
+        const SeriesKey key{9, "PM10"};
+        const qint64 hour = 3600 * 1000;
+        const qint64 start = QDateTime::currentMSecsSinceEpoch() / hour * hour - 10 * hour;
+        SeriesColumns initial;
+        for (int i = 0; i < 5; ++i) {
+            initial.append(start + i * hour, float(10 + i), true);
+        }
+        store.insert(key, initial);
+
+        QChart *chart = new QChart;
+        auto *line = new QLineSeries;
+        for (qsizetype i = 0; i < initial.size(); ++i) {
+            line->append(initial.timestamp(i), initial.value(i));
+        }
+        chart->addSeries(line);
+        auto *axisX = new QDateTimeAxis;
+        axisX->setRange(QDateTime::fromMSecsSinceEpoch(start), QDateTime::fromMSecsSinceEpoch(start + 10 * hour));
+        chart->addAxis(axisX, Qt::AlignBottom);
+        line->attachAxis(axisX);
+        auto *axisY = new QValueAxis;
+        axisY->setRange(10 * 0.9, 14 * 1.1);
+        chart->addAxis(axisY, Qt::AlignLeft);
+        line->attachAxis(axisY);
+
+        auto *window = new ChartWindow("test");
+        window->setAttribute(Qt::WA_DeleteOnClose);
+        window->setCentralWidget(new QChartView(chart));
+        window->attach(&store, RollupLevel::Raw, axisX, axisY, 10.0, 14.0, true);
+        window->addTrace(key, line);
+
+        // Nowe godziny są dopisywane do istniejącej serii, a oś wartości rośnie
+        SeriesColumns update;
+        update.append(start + 5 * hour, 15.0f, true);
+        update.append(start + 6 * hour, 40.0f, true);
+        store.merge(key, update);
+        QCOMPARE(line->count(), 7);
+        QCOMPARE(line->at(6).y(), 40.0);
+        QVERIFY(axisY->max() >= 40.0);
+
+        // Zamknięte okno nie słucha już magazynu i jest usuwane
+        QString closedKey;
+        window->setOnCloseCallback([&closedKey](const QString &chartKey) {
+            closedKey = chartKey;
+        });
+        QPointer<ChartWindow> guard(window);
+        window->show();
+        window->close();
+        QCOMPARE(closedKey, QString("test"));
+        SeriesColumns late;
+        late.append(start + 7 * hour, 17.0f, true);
+        store.merge(key, late);
+        QCOMPARE(line->count(), 7);
+        QTRY_VERIFY(guard.isNull());
+    }
+
+    /**
+     * @brief Testuje, że seria otwartego wykresu nie rośnie bez końca przy wielu odświeżeniach.
+     */
+    void testChartWindowBounded() {
+        const qint64 hour = 3600 * 1000;
+        const qint64 start = QDateTime::currentMSecsSinceEpoch() / hour * hour - 3000 * hour;
+        auto attachWindow = [](ChartWindow &window, SeriesStore &store, const SeriesKey &key,
+                               qint64 from, qint64 to) {
+            QChart *chart = new QChart;
+            auto *line = new QLineSeries;
+            chart->addSeries(line);
+            auto *axisX = new QDateTimeAxis;
+            axisX->setRange(QDateTime::fromMSecsSinceEpoch(from), QDateTime::fromMSecsSinceEpoch(to));
+            chart->addAxis(axisX, Qt::AlignBottom);
+            line->attachAxis(axisX);
+            auto *axisY = new QValueAxis;
+            chart->addAxis(axisY, Qt::AlignLeft);
+            line->attachAxis(axisY);
+            window.setCentralWidget(new QChartView(chart));
+            window.attach(&store, RollupLevel::Raw, axisX, axisY, 0.0, 0.0, true);
+            window.addTrace(key, line);
+            return std::make_pair(line, axisX);
+        };
+
+        // Przewijane okno 10 godzin: po 300 odświeżeniach zostają tylko widoczne punkty
+        SeriesStore store;
+        const SeriesKey key{9, "PM10"};
+        ChartWindow window("przewijany");
+        const auto [line, axisX] = attachWindow(window, store, key, start, start + 10 * hour);
+        for (int i = 0; i < 300; ++i) {
+            SeriesColumns update;
+            update.append(start + i * hour, float(i % 50), true);
+            store.merge(key, update);
+        }
+        QVERIFY(line->count() <= 12);
+        QCOMPARE(qint64(line->at(line->count() - 1).x()), start + 299 * hour);
+        QCOMPARE(axisX->max().toMSecsSinceEpoch(), start + 299 * hour);
+
+        // Szeroki zakres: powyżej szerokości wykresu (ChartPixelWidth = 800) seria jest przerzedzana
+        SeriesStore wideStore;
+        ChartWindow wide("szeroki");
+        QLineSeries *wideLine = attachWindow(wide, wideStore, key, start, start + 2500 * hour).first;
+        for (int batch = 0; batch < 3; ++batch) {
+            SeriesColumns update;
+            for (int i = 0; i < 500; ++i) {
+                const int hourIndex = batch * 500 + i;
+                update.append(start + hourIndex * hour, float(hourIndex % 50), true);
+            }
+            wideStore.merge(key, update);
+        }
+        QVERIFY(wideLine->count() <= 800);
+        QCOMPARE(qint64(wideLine->at(0).x()), start);
+        QCOMPARE(qint64(wideLine->at(wideLine->count() - 1).x()), start + 1499 * hour);
+    }
+
+    /**
+     * @brief Testuje indeks wyszukiwania stacji: podciągi, n-gramy i pomijanie polskich znaków.
+     */
+    void testStationSearchIndex() {
+        QList<Station> stations;
+        stations << Station{10, "Kraków, Aleja Krasińskiego", "Kraków", "Kraków", "Kraków", "MAŁOPOLSKIE"}
+                 << Station{20, "Łódź, ul. Czernika", "Łódź", "Łódź", "Łódź", "ŁÓDZKIE"}
+                 << Station{30, "Warszawa-Ursynów", "Warszawa", "Warszawa", "Warszawa", "MAZOWIECKIE"};
+
+        StationSearchIndex index;
+        index.build(stations);
+        QCOMPARE(index.search("krakow"), QVector<int>{0});
+        QCOMPARE(index.search("LODZ"), QVector<int>{1});
+        QCOMPARE(index.search("ursyn"), QVector<int>{2});
+        QCOMPARE(index.search("ma"), (QVector<int>{0, 2}));
+        // Krótkie i dłuższe zapytania mają tę samą semantykę podciągu
+        QCOMPARE(index.search("ak"), QVector<int>{0});
+        QCOMPARE(index.search("ako"), QVector<int>{0});
+        QCOMPARE(index.search("warszawa mazow"), QVector<int>{2});
+        QCOMPARE(index.search("krakow mazow"), QVector<int>{});
+        QCOMPARE(index.search("").size(), 3);
+    }
+
+    /**
+     * @brief Testuje indeks przestrzenny: najbliższe stacje, promień i prostokąt.
+     */
+    void testStationGeoIndex() {
+        QList<Station> stations;
+        QVERIFY(GiosParser::parseStations(R"([
+            {"id": 1, "stationName": "Kraków", "gegrLat": "50.057678", "gegrLon": "19.926189"},
+            {"id": 2, "stationName": "Skawina", "gegrLat": "49.971075", "gegrLon": "19.828366"},
+            {"id": 3, "stationName": "Warszawa", "gegrLat": "52.219298", "gegrLon": "21.004724"},
+            {"id": 4, "stationName": "Bez współrzędnych"}
+        ])", stations));
+        QVERIFY(stations[0].hasLocation());
+        QVERIFY(!stations[3].hasLocation());
+
+        StationGeoIndex index;
+        index.build(stations);
+        const QVector<StationGeoIndex::Hit> nearest = index.nearest(50.06, 19.94, 2);
+        QCOMPARE(nearest.size(), 2);
+        QCOMPARE(nearest[0].row, 0);
+        QCOMPARE(nearest[1].row, 1);
+        QVERIFY(qAbs(index.distanceKm(50.057678, 19.926189, 52.219298, 21.004724) - 252.0) < 5.0);
+        QCOMPARE(index.within(50.06, 19.94, 50.0).size(), 2);
+        QCOMPARE(index.inBox(52.0, 20.0, 53.0, 22.0), QVector<int>{2});
+    }
+
+    /**
+     * @brief Testuje równoległe grupowanie po województwach i percentyle ze szkicu.
+     */
+    void testRegionReport() {
+        QList<Station> stations;
+        stations << Station{1, "A", "Kraków", "Kraków", "Kraków", "MAŁOPOLSKIE"}
+                 << Station{2, "B", "Tarnów", "Tarnów", "Tarnów", "MAŁOPOLSKIE"}
+                 << Station{3, "C", "Łódź", "Łódź", "Łódź", "ŁÓDZKIE"};
+
+        const RegionReport::SeriesSource source = [](const SeriesKey &key, qint64, qint64) {
+            SeriesColumns series;
+            for (int i = 1; i <= 100; ++i) {
+                series.append(qint64(i) * 3600 * 1000, float(i * key.stationId), true);
+            }
+            return series;
+        };
+
+        const QList<RegionRow> rows = RegionReport::compute(stations, "PM10", RegionLevel::Province, source);
+        QCOMPARE(rows.size(), 2);
+        const RegionRow &south = rows[0].region == "MAŁOPOLSKIE" ? rows[0] : rows[1];
+        const RegionRow &centre = rows[0].region == "MAŁOPOLSKIE" ? rows[1] : rows[0];
+        QCOMPARE(south.stations, 2);
+        QCOMPARE(south.count, qint64(200));
+        QVERIFY(qAbs(south.mean - 75.75) < 1e-9);
+        QCOMPARE(south.max, 200.0);
+        QCOMPARE(centre.region, QString("ŁÓDZKIE"));
+        QVERIFY(qAbs(centre.p50 - 150.0) < 150.0 * 0.01);
+        QVERIFY(qAbs(centre.p90 - 270.0) < 270.0 * 0.01);
+        QCOMPARE(centre.exceedances, qint64(92));
+
+        // Gminy o tej samej nazwie w różnych województwach to osobne wiersze
+        QList<Station> namesakes;
+        namesakes << Station{4, "D", "Wola", "Wola", "pszczyński", "ŚLĄSKIE"}
+                  << Station{5, "E", "Wola", "Wola", "kutnowski", "ŁÓDZKIE"};
+        const QList<RegionRow> communes = RegionReport::compute(namesakes, "PM10", RegionLevel::Commune, source);
+        QCOMPARE(communes.size(), 2);
+        QCOMPARE(communes[0].stations, 1);
+        QCOMPARE(communes[1].stations, 1);
+        QStringList names{communes[0].region, communes[1].region};
+        names.sort();
+        QCOMPARE(names, QStringList({"ŁÓDZKIE/kutnowski/Wola", "ŚLĄSKIE/pszczyński/Wola"}));
+    }
+
+    /**
+     * @brief Testuje eksport długiego i szerokiego CSV oraz pomijanie brakujących odczytów.
+     */
+    void testSeriesExport() {
+        const SeriesSource source = [](const SeriesKey &key, qint64 from, qint64 to) {
+            SeriesColumns series;
+            for (int i = 0; i < 48; i += key.stationId) {
+                const qint64 ts = QDateTime(QDate(2025, 1, 1), QTime(0, 0)).toMSecsSinceEpoch() + qint64(i) * 3600 * 1000;
+                if (ts >= from && ts <= to) {
+                    series.append(ts, float(i), i != 4);
+                }
+            }
+            return series;
+        };
+
+        ExportOptions options;
+        options.path = "test_eksport.csv";
+        options.keys << SeriesKey{1, "PM10"} << SeriesKey{2, "NO2"};
+        QCOMPARE(SeriesExporter::run(options, source), QString());
+
+        QFile file(options.path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QList<QByteArray> lines = file.readAll().split('\n');
+        file.close();
+        QCOMPARE(lines.first(), QString("Stacja;Parametr;Data;Wartość").toUtf8());
+        QCOMPARE(lines.size(), 1 + 47 + 23 + 1);
+        QCOMPARE(lines[1], QByteArray("1;PM10;2025-01-01 00:00:00;0"));
+        QCOMPARE(lines[6], QByteArray("1;PM10;2025-01-01 06:00:00;6"));
+
+        options.layout = ExportOptions::Layout::WideCsv;
+        QCOMPARE(SeriesExporter::run(options, source), QString());
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        lines = file.readAll().split('\n');
+        file.close();
+        QCOMPARE(lines.first(), QByteArray("Data;1_PM10;2_NO2"));
+        QCOMPARE(lines.size(), 1 + 48 + 1);
+        QCOMPARE(lines[2], QByteArray("2025-01-01 01:00:00;1;"));
+        QCOMPARE(lines[5], QByteArray("2025-01-01 04:00:00;;"));
+        QFile::remove(options.path);
+    }
+
+    /**
+     * @brief Testuje renderowanie wykresu poza ekranem w zadanej rozdzielczości.
+     */
+    void testChartRendererOffscreen() {
+        SeriesColumns columns;
+        for (int i = 0; i < 500; ++i) {
+            columns.append(qint64(i) * 3600 * 1000, float(i % 50), true);
+        }
+        const SeriesSource source = [&columns](const SeriesKey &, qint64, qint64) { return columns; };
+
+        const ChartSpec spec = ChartRenderer::fromSource(source, {SeriesKey{1, "PM10"}}, 0, qint64(499) * 3600 * 1000, 800);
+        QCOMPARE(spec.traces.size(), qsizetype(1));
+        QCOMPARE(spec.level, RollupLevel::Raw);
+        QVERIFY(spec.traces.first().points.size() <= 800);
+        QCOMPARE(spec.minY, 0.0);
+        QCOMPARE(spec.maxY, 49.0);
+
+        const QImage image = ChartRenderer::render(spec, QSize(400, 300), 192.0);
+        QCOMPARE(image.size(), QSize(800, 600));
+        QVERIFY(image.pixelColor(0, 0).isValid());
+
+        ChartRenderer::Job job;
+        job.keys = {SeriesKey{1, "PM10"}};
+        job.path = "test_wykres.svg";
+        QVERIFY(ChartRenderer::renderAll({job}, source, 0, qint64(499) * 3600 * 1000, QSize(400, 300)).isEmpty());
+        QVERIFY(QFile::exists(job.path));
+        QFile::remove(job.path);
+    }
+
+    /**
+     * @brief Testuje ustawianie adresu bazowego API.
+     */
+    void testApiBaseUrl() {
+        ApiManager api;
+        api.setBaseUrl(QUrl("http://127.0.0.1:8080/rest"));
+        QCOMPARE(api.baseUrl(), QUrl("http://127.0.0.1:8080/rest/"));
+        api.setBaseUrl(QUrl("http://127.0.0.1:8080/"));
+        QCOMPARE(api.baseUrl(), QUrl("http://127.0.0.1:8080/"));
+        if (qEnvironmentVariableIsEmpty("GIOS_API_URL")) {
+            QCOMPARE(ApiManager::defaultBaseUrl(), QUrl("https://api.gios.gov.pl/pjp-api/rest/"));
+        }
+    }
+
+    /**
+     * @brief Testuje lokalny serwer GIOŚ: ścieżki endpointów, dane syntetyczne i wstrzykiwanie błędów.
+     */
+    void testMockGiosServer() {
+        QCOMPARE(MockGiosServer::apiPath("/pjp-api/rest/station/sensors/114?format=json"), QString("station/sensors/114"));
+        QCOMPARE(MockGiosServer::apiPath("/data/getData/92"), QString("data/getData/92"));
+        QCOMPARE(MockGiosServer::fileNameFor("station/sensors/114"), QString("station_sensors_114.json"));
+
+        MockOptions options;
+        options.stations = 3;
+        options.sensorsPerStation = 2;
+        MockGiosServer server(options);
+        QVERIFY(server.listen());
+        ApiManager api;
+        api.setBaseUrl(mockBaseUrl(server));
+
+        QList<Station> stations;
+        QList<Sensor> sensors;
+        connect(&api, &ApiManager::stationsReceived, this, [&](const QList<Station> &received) {
+            stations = received;
+        });
+        connect(&api, &ApiManager::sensorsReceived, this, [&](int, const QList<Sensor> &received) {
+            sensors = received;
+        });
+        api.getAirStations();
+        QTRY_COMPARE(stations.size(), 3);
+        QCOMPARE(stations.first().id, 100);
+        api.getSensorsForStation(101);
+        QTRY_COMPARE(sensors.size(), 2);
+        QCOMPARE(sensors.first().id, SyntheticData::sensorId(101, 0));
+
+        // Każda odpowiedź to błąd serwera - trafia do requestFailed z kontekstem żądania
+        MockOptions failing = options;
+        failing.serverErrorRate = 1.0;
+        MockGiosServer failingServer(failing);
+        QVERIFY(failingServer.listen());
+        api.setBaseUrl(mockBaseUrl(failingServer));
+        int failedStation = 0;
+        connect(&api, &ApiManager::requestFailed, this, [&](RequestKind kind, int stationId, int, const QString &) {
+            if (kind == RequestKind::Sensors)
+                failedStation = stationId;
+        });
+        api.getSensorsForStation(199);
+        QTRY_COMPARE(failedStation, 199);
+        QCOMPARE(failingServer.stats().serverErrors, qint64(1));
+    }
+
+    /**
+     * @brief Testuje pełne pobieranie z lokalnego serwera: liczniki postępu i zawartość archiwum.
+     */
+    void testBulkCrawler() {
+        MockOptions options;
+        options.stations = 3;
+        options.sensorsPerStation = 2;
+        options.hours = 24;
+        MockGiosServer server(options);
+        QVERIFY(server.listen());
+        ApiManager api;
+        api.setBaseUrl(mockBaseUrl(server));
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        MeasurementArchive archive(dir.path());
+        BulkCrawler crawler(&api, &archive);
+        crawler.setConcurrency(4);
+        bool finished = false;
+        BulkCrawler::Stats result;
+        connect(&crawler, &BulkCrawler::finished, this, [&](const BulkCrawler::Stats &stats) {
+            result = stats;
+            finished = true;
+        });
+
+        crawler.start();
+        QVERIFY(crawler.isRunning());
+        QCOMPARE(api.maxInFlight(), 4);
+        QTRY_VERIFY(finished);
+        QVERIFY(!crawler.isRunning());
+        QCOMPARE(result.stations, 3);
+        QCOMPARE(result.sensorListsDone, 3);
+        QCOMPARE(result.sensorsTotal, 6);
+        QCOMPARE(result.sensorsDone, 6);
+        QCOMPARE(result.failures, 0);
+        QCOMPARE(result.requests, qint64(1 + 3 + 6));
+        QVERIFY(result.points > 0);
+        QCOMPARE(server.stats().requests, qint64(1 + 3 + 6));
+
+        // finished przychodzi po opróżnieniu kolejki zapisu, więc archiwum jest kompletne
+        const QList<SeriesKey> keys = archive.keys();
+        QCOMPARE(keys.size(), 6);
+        QVERIFY(!archive.read(keys.first()).isEmpty());
+    }
+
+    /**
+     * @brief Testuje histogram opóźnień i zapis śladu w formacie Chrome trace-event.
+     */
+    void testTracer() {
+        Tracer::Histogram histogram;
+        for (int i = 1; i <= 100; ++i) {
+            histogram.add(qint64(i) * 1000000);
+        }
+        QCOMPARE(histogram.count, qint64(100));
+        QVERIFY(qAbs(histogram.quantileNs(0.5) - 50e6) < 50e6 * 0.2);
+        QCOMPARE(histogram.quantileNs(1.0), qint64(100000000));
+
+        Tracer &tracer = Tracer::instance();
+        tracer.clear();
+        Tracer::setEnabled(false);
+        { TraceSpan ignored("wyłączony"); }
+        Tracer::setEnabled(true);
+        { TraceSpan span("test", "test"); }
+        tracer.asyncSpan("queued", "http", 7, Tracer::now(), Tracer::now(), "station/\"findAll\"");
+        tracer.count("http.stations.requests");
+        Tracer::setEnabled(false);
+
+        QVERIFY(tracer.writeChromeTrace("test_slad.json"));
+        QFile file("test_slad.json");
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+        file.close();
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(doc.object()["traceEvents"].toArray().size(), qsizetype(4));   // metadane, X, b, e
+        QCOMPARE(tracer.counters().value("http.stations.requests"), qint64(1));
+        QFile::remove("test_slad.json");
+        tracer.clear();
+    }
+
+    /**
+     * @brief Testuje wątek zapisu: zapis pliku przez zmianę nazwy, scalanie zapisów i ingest do archiwum.
+     */
+    void testAsyncWriter() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        AsyncWriter writer;
+        const QString path = dir.filePath("podkatalog/stacje.json");
+        writer.writeFile(path, "[1]");
+        writer.writeFile(path, "[1,2]");
+
+        MeasurementArchive archive(dir.filePath("archiwum"));
+        const SeriesKey key{7, "NO2"};
+        const qint64 hour = 3600 * 1000;
+        SeriesColumns first;
+        first.append(0 * hour, 20.0f, true);
+        first.append(1 * hour, 21.0f, true);
+        SeriesColumns second;
+        second.append(1 * hour, 0.0f, false);    // Brak odczytu nie nadpisuje ważnego pomiaru
+        second.append(2 * hour, 22.0f, true);
+        writer.ingest(archive, key, first);
+        writer.ingest(archive, key, second);
+        writer.flush();
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QCOMPARE(file.readAll(), QByteArray("[1,2]"));
+        file.close();
+
+        const SeriesColumns stored = archive.read(key);
+        QCOMPARE(stored.size(), qsizetype(3));
+        QVERIFY(stored.isValid(1));
+        QCOMPARE(stored.value(1), 21.0f);
+        QCOMPARE(stored.value(2), 22.0f);
+
+        const AsyncWriter::Stats stats = writer.stats();
+        QCOMPARE(stats.jobs, qint64(4));
+        QCOMPARE(stats.queuedBytes, qint64(0));
+        QCOMPARE(stats.failures, qint64(0));
+        QVERIFY(!writer.isCongested());
+
+        // Błąd zapisu do archiwum (katalog archiwum jest zwykłym plikiem) jest liczony i zgłaszany
+        QSignalSpy failed(&writer, &AsyncWriter::writeFailed);
+        writer.ingest(MeasurementArchive(path), key, first);
+        writer.flush();
+        QCOMPARE(writer.stats().failures, qint64(1));
+        QTRY_COMPARE(failed.count(), 1);
+    }
+
+    /**
+     * @brief Testuje, że przepełniona kolejka zapisu wstrzymuje wysyłanie żądań ApiManager.
+     */
+    void testWriterBackpressure() {
+        ApiManager api;
+        emit AsyncWriter::instance().congestionChanged(true);
+        api.getSensorsForStation(100);
+        QCOMPARE(api.pendingCount(), 1);
+        QCOMPARE(api.inFlightCount(), 0);
+        QVERIFY(!api.isPaused());
+
+        // Po rozładowaniu kolejki zapisu czekające żądania wychodzą od razu
+        emit AsyncWriter::instance().congestionChanged(false);
+        QCOMPARE(api.pendingCount(), 0);
+        QCOMPARE(api.inFlightCount(), 1);
+        api.cancelStation(100);
+        QCOMPARE(api.inFlightCount(), 0);
+    }
+
+    /**
+     * @brief Testuje migawkę katalogu stacji: napisy bez powtórzeń, wyszukiwanie po ID i model listy.
+     */
+    void testStationSnapshot() {
+        QList<Station> stations;
+        QVERIFY(GiosParser::parseStations(R"([
+            {"id": 30, "stationName": "Kraków, Aleja Krasińskiego", "gegrLat": "50.057678", "gegrLon": "19.926189",
+             "city": {"name": "Kraków", "commune": {"communeName": "Kraków", "districtName": "Kraków", "provinceName": "MAŁOPOLSKIE"}}},
+            {"id": 10, "stationName": "Kraków, ul. Bujaka",
+             "city": {"name": "Kraków", "commune": {"communeName": "Kraków", "districtName": "Kraków", "provinceName": "MAŁOPOLSKIE"}}},
+            {"id": 20, "stationName": "Skawina"}
+        ])", stations));
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath("stacje.bin");
+        const QByteArray data = StationSnapshot::serialize(stations, 1700000000000);
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(data);
+        file.close();
+
+        auto snapshot = std::make_shared<StationSnapshot>(path);
+        QVERIFY(snapshot->open());
+        QCOMPARE(snapshot->size(), 3);
+        QCOMPARE(snapshot->savedAt(), qint64(1700000000000));
+        QCOMPARE(snapshot->contentHash(), StationSnapshot::contentHash(data));
+        QCOMPARE(StationSnapshot::storedHash(path), snapshot->contentHash());
+        QCOMPARE(snapshot->station(0).name, QString("Kraków, Aleja Krasińskiego"));
+        QCOMPARE(snapshot->station(1).provinceName, QString("MAŁOPOLSKIE"));
+        QVERIFY(snapshot->station(0).hasLocation());
+        QVERIFY(!snapshot->station(2).hasLocation());
+        QCOMPARE(snapshot->rowOf(20), 2);
+        QCOMPARE(snapshot->rowOf(99), -1);
+        QCOMPARE(snapshot->stations().size(), 3);
+        QCOMPARE(snapshot->stations()[1].cityName, QString("Kraków"));
+
+        // Lista jest dostępna od razu, indeksy powstają w tle
+        StationListModel model;
+        model.setSnapshot(snapshot);
+        QCOMPARE(model.rowCount(), 3);
+        QCOMPARE(model.stationById(10)->name, QString("Kraków, ul. Bujaka"));
+        QTRY_VERIFY(model.isIndexed());
+        QCOMPARE(model.stations().size(), 3);
+        // Po zbudowaniu indeksów model nie trzyma mapowania, tylko skrót zawartości
+        QCOMPARE(model.contentHash(), snapshot->contentHash());
+        QTRY_COMPARE(snapshot.use_count(), long(1));
+        QCOMPARE(model.searchIndex().search("skawina"), QVector<int>{2});
+
+        // Zmieniony katalog ma inny skrót; uszkodzony plik jest odrzucany
+        stations[2].name = "Skawina, os. Ogrody";
+        QVERIFY(StationSnapshot::contentHash(StationSnapshot::serialize(stations, 0)) != snapshot->contentHash());
+        QFile truncatedFile(dir.filePath("uszkodzona.bin"));
+        QVERIFY(truncatedFile.open(QIODevice::WriteOnly));
+        truncatedFile.write(data.left(data.size() - 1));
+        truncatedFile.close();
+        StationSnapshot truncated(truncatedFile.fileName());
+        QVERIFY(!truncated.open());
+
+        // Katalog JSON ze starszej wersji jest jednorazowo przenoszony do migawki
+        const QString legacyPath = dir.filePath("stacje.json");
+        const QString migratedPath = dir.filePath("migracja.bin");
+        QFile legacy(legacyPath);
+        QVERIFY(legacy.open(QIODevice::WriteOnly));
+        legacy.write(R"([{"id": 5, "stationName": "Stara stacja", "city": {"name": "Kraków"}}])");
+        legacy.close();
+        QVERIFY(StationSnapshot::importJson(legacyPath, migratedPath));
+        QVERIFY(!StationSnapshot::importJson(legacyPath, migratedPath));
+        StationSnapshot migrated(migratedPath);
+        QVERIFY(migrated.open());
+        QCOMPARE(migrated.size(), 1);
+        QCOMPARE(migrated.station(0).name, QString("Stara stacja"));
+    }
+
+    /**
+     * @brief Testuje zapis i odczyt danych do/z pliku JSON.
+     */
+    void testSaveAndReadFile() {
+        QString json = "[{\"stationName\": \"Test Station\", \"id\": 1}]";
+        QFile file("test_stacje.json");
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream out(&file);
+        out << json;
+        file.close();
+        QVERIFY(file.exists());
+
+        QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        QString readData = file.readAll();
+        file.close();
+        QCOMPARE(readData, json);
+
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(readData.toUtf8(), &parseError);
+        QVERIFY(parseError.error == QJsonParseError::NoError);
+        QVERIFY(doc.isArray());
+        QCOMPARE(doc.array().size(), 1);
+        QFile::remove("test_stacje.json");
+    }
+
+    /**
+     * @brief Testuje filtrowanie stacji po nazwie miasta.
+     */
+    void testFilterStationsByCity() {
+        MainWindow mainWindow;
+        QString json = R"([
+            {"stationName": "Stacja Warszawa", "id": 1, "city": {"name": "Warszawa"}},
+            {"stationName": "Stacja Kraków", "id": 2, "city": {"name": "Kraków"}}
+        ])";
+        mainWindow.showStationsInList(json);
+
+        // Filtruj stacje dla miasta "Warszawa"
+        mainWindow.filterStationsByCity("Warszawa");
+        QCOMPARE(mainWindow.getStationListCount(), 1);
+
+        // Filtruj bez ograniczeń (wszystkie stacje)
+        mainWindow.filterStationsByCity("");
+        QCOMPARE(mainWindow.getStationListCount(), 2);
+
+        // Przetwarzanie pętli zdarzeń, aby upewnić się, że GUI się zaktualizowało
+        QCoreApplication::processEvents();
+    }
+
+    /**
+     * @brief Testuje obsługę pustej odpowiedzi API.
+     */
+    void testEmptyApiResponse() {
+        MainWindow mainWindow;
+        // Ostrzeżenie o błędnym JSON jest modalne - zamykamy je, gdy się pojawi
+        closeModalDialogs();
+        mainWindow.showStationsInList("");
+        QCOMPARE(mainWindow.getStationListCount(), 0);
+
+        // Przetwarzanie pętli zdarzeń
+        QCoreApplication::processEvents();
+    }
+
+    /**
+     * @brief Testuje analizę danych dla parametru PM10.
+     */
+    void testAnalyzePM10() {
+        MainWindow mainWindow;
+        QString json = R"({"key": "PM10", "values": [
+            {"date": "2023-10-01", "value": 20.0},
+            {"date": "2023-10-02", "value": 30.0},
+            {"date": "2023-10-03", "value": 25.0}
+        ]})";
+        QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
+        QJsonArray values = doc.object()["values"].toArray();
+        mainWindow.setTestData("PM10", values);
+
+        // Parametr musi być zaznaczony na liście, inaczej analiza kończy się modalnym ostrzeżeniem
+        QListWidget *params = mainWindow.findChild<QListWidget *>("paramListWidget");
+        QVERIFY(params);
+        params->addItem("PM10");
+        params->item(0)->setSelected(true);
+
+        // Symulacja kliknięcia przycisku analizy; wynik pojawia się w niemodalnym oknie
+        mainWindow.on_analyzeButton_clicked();
+        QMessageBox *box = mainWindow.findChild<QMessageBox *>();
+        QVERIFY(box);
+        QTRY_VERIFY(box->standardButtons() == QMessageBox::Ok);
+        QVERIFY(!box->text().startsWith("Brak"));
+        box->close();
+    }
+
+private:
+    /**
+     * @brief Adres bazowy API wskazujący na lokalny serwer testowy.
+     * @param server Serwer, który już nasłuchuje.
+     */
+    static QUrl mockBaseUrl(const MockGiosServer &server) {
+        return QUrl(QString("http://127.0.0.1:%1/").arg(server.serverPort()));
+    }
+
+    /**
+     * @brief Zamyka okno modalne otwarte w trakcie bieżącego testu (np. QMessageBox::warning).
+     * @param attempts Liczba kolejnych sprawdzeń co 10 ms, zanim próba zostanie porzucona.
+     */
+    void closeModalDialogs(int attempts = 100) {
+        QTimer::singleShot(10, this, [this, attempts]() {
+            if (QWidget *dialog = QApplication::activeModalWidget()) {
+                dialog->close();
+            } else if (attempts > 1) {
+                closeModalDialogs(attempts - 1);
+            }
+        });
+    }
+
+    QTemporaryDir m_workDir;  ///< Katalog roboczy testów (migawki, pliki tymczasowe).
+    QString m_originalDir;    ///< Katalog roboczy sprzed testów, przywracany na końcu.
+};
+
+/**
+ * @brief Odpowiednik QTEST_MAIN, który bez ustawionej platformy wybiera offscreen,
+ * więc testy MainWindow i wykresów działają także bez serwera wyświetlania.
+ */
+int main(int argc, char *argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    TestApiManager test;
+    QTEST_SET_MAIN_SOURCE_PATH
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "test_apimanager.moc"
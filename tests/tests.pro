@@ -0,0 +1,28 @@
+QT       += core gui network charts concurrent svg widgets testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+TARGET = pogoda-tests
+
+include(../core/core.pri)
+
+# Testy okna głównego i renderowania wykresów kompilują źródła gui razem z testami,
+# a testy pobierania - lokalny serwer GIOŚ z danymi syntetycznymi
+INCLUDEPATH += ../gui ../mockserver ../benchmarks
+DEPENDPATH += ../gui ../mockserver ../benchmarks
+
+SOURCES += \
+    ../benchmarks/syntheticdata.cpp \
+    ../gui/chartrenderer.cpp \
+    ../gui/mainwindow.cpp \
+    ../mockserver/mockgiosserver.cpp \
+    test_apimanager.cpp
+
+HEADERS += \
+    ../benchmarks/syntheticdata.h \
+    ../gui/chartrenderer.h \
+    ../gui/mainwindow.h \
+    ../mockserver/mockgiosserver.h
+
+FORMS += \
+    ../gui/mainwindow.ui